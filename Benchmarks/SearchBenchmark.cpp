@@ -0,0 +1,556 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <functional>
+#include <thread>
+#include <cstdlib>
+#include "../Search_Common/Search.h"
+#include "../Search_Common/SlidingPuzzleProblem.h"
+#include "../Search_Common/SlidingPuzzleIDA.h"
+#include "../Search_Common/RandomWalkBoard.h"
+#include "../Search_Common/KorfInstances.h"
+#include "../Search_Common/PatternDatabase.h"
+#include "../Search_Common/QueensProblem.h"
+#include "../Search_Common/BitboardQueens.h"
+#include "../Search_Common/TicTacToeProblem.h"
+#include "../Search_Common/TicTacToePerfectPlay.h"
+#include "../Search_Common/MnkGame.h"
+#include "../Search_Common/MnkMcts.h"
+#include "../Search_Common/BenchmarkStats.h"
+
+using namespace std;
+
+// Totals of one pass over a suite. The checksum (solution lengths, solution
+// counts or game values) must come out the same in every repetition; a
+// change between builds means a solver now returns different answers.
+struct RunResult
+{
+    int instances = 0;
+    int solved = 0;
+    uint64_t expanded = 0;
+    uint64_t generated = 0;
+    uint64_t checksum = 0;
+    SearchStats profile; // summed over the Search<> runs of the suite
+};
+
+struct BenchmarkCase
+{
+    string suite;
+    string solver;
+    function<RunResult()> run;
+};
+
+// 8-puzzle: random walks of the goal at several depths
+const int WALK_DEPTHS[] = {10, 20, 30, 60};
+const int WALK_BOARDS = 20;
+
+// 15-puzzle: the Korf instances that IDA* with Manhattan distance solves in
+// about a second or less, so the default run stays short; --korf all runs the 100
+const int KORF_QUICK[] = {2, 5, 9, 12, 13, 16, 19, 23, 28, 30, 31};
+
+// Shortest time measured per repetition
+const double MIN_REP_SECONDS = 0.05;
+
+typedef SlidingPuzzleProblem<3> EightPuzzle;
+
+vector<PackedPuzzle<3>> walkBoards(int depth)
+{
+    vector<PackedPuzzle<3>> boards;
+    for (int i = 0; i < WALK_BOARDS; i++)
+    {
+        boards.push_back(PackedPuzzle<3>::fromCells(randomWalkBoard<3>(depth, depth * 1000 + i).data()));
+    }
+    return boards;
+}
+
+// Runs one Search<> algorithm over every board
+template <class Solve>
+RunResult runEightPuzzle(const vector<PackedPuzzle<3>> &boards, Solve solve)
+{
+    EightPuzzle problem;
+    Search<EightPuzzle> search(problem);
+    search.reportTo(nullptr);
+    RunResult result;
+    for (const PackedPuzzle<3> &board : boards)
+    {
+        uint32_t goal = solve(search, board);
+        result.instances++;
+        if (goal != Search<EightPuzzle>::NO_NODE)
+        {
+            result.solved++;
+            result.checksum += search.arena().g(goal);
+        }
+        result.expanded += search.nodesExpanded();
+        result.generated += search.nodesGenerated();
+        result.profile += search.stats();
+    }
+    return result;
+}
+
+template <int W>
+RunResult runSlidingIDA(const vector<vector<int>> &boards, const int *goal, const PatternDatabase *pdb)
+{
+    SlidingPuzzleIDA<W> solver(goal);
+    if (pdb != nullptr)
+        solver.usePatternDatabase(pdb);
+    vector<int> solution;
+    RunResult result;
+    for (const vector<int> &board : boards)
+    {
+        result.instances++;
+        if (solver.solve(board.data(), solution))
+        {
+            result.solved++;
+            result.checksum += solution.size();
+        }
+        result.expanded += solver.nodesExpanded();
+        result.generated += solver.nodesGenerated();
+    }
+    return result;
+}
+
+void addEightPuzzleCases(vector<BenchmarkCase> &cases)
+{
+    for (int depth : WALK_DEPTHS)
+    {
+        string suite = "8-puzzle-walk-" + to_string(depth);
+        vector<PackedPuzzle<3>> boards = walkBoards(depth);
+        vector<vector<int>> cells;
+        for (const PackedPuzzle<3> &board : boards)
+        {
+            vector<int> row;
+            for (int cell = 0; cell < 9; cell++)
+            {
+                row.push_back(board.tileAt(cell));
+            }
+            cells.push_back(row);
+        }
+
+        cases.push_back({suite, "bfs", [=]()
+                         { return runEightPuzzle(boards, [](Search<EightPuzzle> &s, const PackedPuzzle<3> &b)
+                                                 { return s.breadthFirst(b); }); }});
+        cases.push_back({suite, "dfs", [=]()
+                         { return runEightPuzzle(boards, [](Search<EightPuzzle> &s, const PackedPuzzle<3> &b)
+                                                 { return s.depthFirst(b); }); }});
+        cases.push_back({suite, "greedy", [=]()
+                         { return runEightPuzzle(boards, [](Search<EightPuzzle> &s, const PackedPuzzle<3> &b)
+                                                 { return s.greedyBestFirst(b); }); }});
+        cases.push_back({suite, "a-star", [=]()
+                         { return runEightPuzzle(boards, [](Search<EightPuzzle> &s, const PackedPuzzle<3> &b)
+                                                 { return s.aStar(b); }); }});
+        cases.push_back({suite, "ida-star", [=]()
+                         { return runSlidingIDA<3>(cells, nullptr, nullptr); }});
+    }
+}
+
+void addKorfCases(vector<BenchmarkCase> &cases, const vector<int> &instances, const PatternDatabase *pdb)
+{
+    vector<vector<int>> boards;
+    for (int i : instances)
+    {
+        boards.push_back(vector<int>(KORF_INSTANCES[i - 1], KORF_INSTANCES[i - 1] + 16));
+    }
+    cases.push_back({"15-puzzle-korf", pdb != nullptr ? "ida-star-pdb" : "ida-star", [=]()
+                     { return runSlidingIDA<4>(boards, KORF_GOAL, pdb); }});
+}
+
+// Search<> over queen placements; onGoal decides between the first
+// solution and all of them
+template <class Run>
+RunResult runQueens(int n, Run run)
+{
+    QueensPlacementProblem problem(n);
+    Search<QueensPlacementProblem> search(problem);
+    search.reportTo(nullptr);
+    RunResult result;
+    result.instances = 1;
+    uint64_t solutions = run(search);
+    result.solved = solutions > 0;
+    result.checksum = solutions;
+    result.expanded = search.nodesExpanded();
+    result.generated = search.nodesGenerated();
+    result.profile = search.stats();
+    return result;
+}
+
+void addQueensCases(vector<BenchmarkCase> &cases)
+{
+    // PackedQueens holds boards up to 15 x 15
+    for (int n = 4; n <= 15; n++)
+    {
+        string suite = "queens-" + to_string(n);
+        cases.push_back({suite, "dfs-first", [=]()
+                         { return runQueens(n, [](Search<QueensPlacementProblem> &s)
+                                            { return uint64_t(s.depthFirst(PackedQueens()) != Search<QueensPlacementProblem>::NO_NODE); }); }});
+        cases.push_back({suite, "a-star-first", [=]()
+                         { return runQueens(n, [](Search<QueensPlacementProblem> &s)
+                                            { return uint64_t(s.aStar(PackedQueens()) != Search<QueensPlacementProblem>::NO_NODE); }); }});
+        if (n <= 12)
+        {
+            cases.push_back({suite, "dfs-count", [=]()
+                             { return runQueens(n, [](Search<QueensPlacementProblem> &s)
+                                                {
+                uint64_t count = 0;
+                s.depthFirst(PackedQueens(), [&](uint32_t)
+                             {
+                    count++;
+                    return false; });
+                return count; }); }});
+        }
+    }
+
+    // Bitmask backtracking, counting everything and stopping at the first
+    for (int n = 4; n <= 16; n++)
+    {
+        cases.push_back({"queens-" + to_string(n), "bitboard-count", [=]()
+                         {
+            BitboardQueens queens(n);
+            RunResult result;
+            result.instances = 1;
+            result.checksum = queens.count();
+            result.solved = result.checksum > 0;
+            result.generated = queens.nodesGenerated();
+            return result; }});
+    }
+    // Same counts split over every core by work stealing
+    for (int n = 8; n <= 16; n++)
+    {
+        cases.push_back({"queens-" + to_string(n), "bitboard-parallel-count", [=]()
+                         {
+            BitboardQueens queens(n);
+            RunResult result;
+            result.instances = 1;
+            result.checksum = queens.countParallel(max(1, int(thread::hardware_concurrency())));
+            result.solved = result.checksum > 0;
+            result.generated = queens.nodesGenerated();
+            return result; }});
+    }
+    // One solution per symmetry class; the checksum folds in the total the
+    // multiplicities add up to
+    for (int n = 4; n <= 16; n++)
+    {
+        cases.push_back({"queens-" + to_string(n), "bitboard-unique", [=]()
+                         {
+            BitboardQueens queens(n);
+            RunResult result;
+            uint64_t total;
+            result.instances = 1;
+            uint64_t fundamental = queens.countFundamental(total);
+            result.solved = fundamental > 0;
+            result.checksum = fundamental * 1000003 + total;
+            result.generated = queens.nodesGenerated();
+            return result; }});
+    }
+    for (int n = 4; n <= 20; n++)
+    {
+        cases.push_back({"queens-" + to_string(n), "bitboard-first", [=]()
+                         {
+            BitboardQueens queens(n);
+            RunResult result;
+            result.instances = 1;
+            result.solved = int(queens.forEachSolution([](const int *)
+                                                       { return false; }));
+            result.checksum = result.solved;
+            result.generated = queens.nodesGenerated();
+            return result; }});
+    }
+
+    // Repair search from all queens on the first square; the rank space is n^n
+    for (int n = 4; n <= 8; n++)
+    {
+        cases.push_back({"queens-" + to_string(n), "greedy-repair", [=]()
+                         {
+            QueensRepairProblem problem(n);
+            Search<QueensRepairProblem> search(problem);
+            search.reportTo(nullptr);
+            PackedQueens start;
+            for (int line = 0; line < n; line++)
+            {
+                start = start.placed(line, 0);
+            }
+            RunResult result;
+            result.instances = 1;
+            uint32_t goal = search.greedyBestFirst(start);
+            result.solved = goal != Search<QueensRepairProblem>::NO_NODE;
+            result.checksum = result.solved ? search.arena().g(goal) : 0;
+            result.expanded = search.nodesExpanded();
+            result.generated = search.nodesGenerated();
+            result.profile = search.stats();
+            return result; }});
+    }
+}
+
+// Game value for the player to move: 1 win, 0 draw, -1 loss. Positions are
+// memoised by rank (0 = not solved yet, otherwise value + 2).
+int solveTicTacToe(const TicTacToeBoard &board, const TicTacToeProblem &problem, vector<uint8_t> &memo, RunResult &result)
+{
+    uint8_t &entry = memo[problem.rank(board)];
+    if (entry != 0)
+        return entry - 2;
+
+    result.expanded++;
+    int value;
+    if (problem.isGoal(board))
+        value = -1; // the previous player just completed a line
+    else if (board.markCount() == 9)
+        value = 0;
+    else
+    {
+        value = -1;
+        problem.forEachSuccessor(board, [&](const TicTacToeBoard &next, int)
+                                 {
+            result.generated++;
+            value = max(value, -solveTicTacToe(next, problem, memo, result)); });
+    }
+    entry = uint8_t(value + 2);
+    return value;
+}
+
+void addTicTacToeCases(vector<BenchmarkCase> &cases)
+{
+    // Every reachable position, breadth first
+    cases.push_back({"tic-tac-toe", "bfs-all-positions", []()
+                     {
+        TicTacToeProblem problem;
+        Search<TicTacToeProblem> search(problem);
+        search.reportTo(nullptr);
+        RunResult result;
+        result.instances = 1;
+        search.breadthFirst(TicTacToeBoard(), [&](uint32_t)
+                            {
+            result.checksum++; // won positions
+            return false; });
+        result.solved = 1;
+        result.expanded = search.nodesExpanded();
+        result.generated = search.nodesGenerated();
+        result.profile = search.stats();
+        return result; }});
+
+    // Game value of the empty board by memoised negamax
+    cases.push_back({"tic-tac-toe", "negamax-solve", []()
+                     {
+        TicTacToeProblem problem;
+        vector<uint8_t> memo(problem.stateCount(), 0);
+        RunResult result;
+        result.instances = 1;
+        result.checksum = solveTicTacToe(TicTacToeBoard(), problem, memo, result) + 1; // 1 = draw
+        result.solved = 1;
+        return result; }});
+
+    // Perfect play from every opening move, one compiled-table lookup a move
+    cases.push_back({"tic-tac-toe", "perfect-table-play", []()
+                     {
+        RunResult result;
+        result.instances = 9;
+        for (int first = 0; first < 9; first++)
+        {
+            TicTacToeBoard board = TicTacToeBoard().marked(first, TTT_X);
+            while (!board.isGameOver())
+            {
+                board = board.marked(perfectMove(board), board.playerToMove());
+                result.expanded++;
+                result.generated++;
+            }
+            result.checksum = result.checksum * 3 + (board.hasWon(TTT_X) ? 1 : board.hasWon(TTT_O) ? 2 : 0);
+            result.solved++;
+        }
+        return result; }});
+}
+
+// m,n,k-games: small boards solved from the empty board by alpha-beta with
+// a fresh transposition table (both are draws), and an MCTS search on gomoku
+void addMnkCases(vector<BenchmarkCase> &cases)
+{
+    for (int side : {3, 4})
+    {
+        string suite = "mnk-" + to_string(side) + "," + to_string(side) + "," + to_string(side);
+        cases.push_back({suite, "alpha-beta-solve", [=]()
+                         {
+            MnkGame game(side, side, side, 0);
+            MnkSearch search(game);
+            MnkSearch::Iteration it = search.iterativeDeepening(MnkSearch::MAX_PLY, 0);
+            RunResult result;
+            result.instances = 1;
+            result.solved = search.isExact(it);
+            result.expanded = it.nodes;
+            result.generated = it.nodes;
+            result.checksum = MnkSearch::outcome(it) + 1; // 1 = draw
+            return result; }});
+    }
+
+    // Gomoku reply to the centre opening: a fixed number of playouts on one
+    // thread, so the chosen move is reproducible
+    cases.push_back({"mnk-15,15,5", "mcts-20000-playouts", []()
+                     {
+        MnkGame game(15, 15, 5);
+        game.play(7 * 15 + 7);
+        MnkMcts::Settings settings;
+        settings.millis = 1e9;
+        settings.maxPlayouts = 20000;
+        settings.poolNodes = 1 << 18;
+        MnkMcts mcts(settings);
+        MnkMcts::Result search = mcts.search(game);
+        RunResult result;
+        result.instances = 1;
+        result.solved = search.move >= 0;
+        result.expanded = search.playouts;
+        result.generated = search.nodes;
+        result.checksum = uint64_t(search.move) * 1000003 + uint64_t(search.moves[0].visits);
+        return result; }});
+}
+
+void writeCase(ostream &out, const BenchmarkCase &bench, const RunResult &result, int calls,
+               const SampleStats &seconds, const SampleStats &rates, uint64_t peakRss)
+{
+    out << "    {\"suite\": \"" << bench.suite << "\", \"solver\": \"" << bench.solver << "\""
+        << ", \"instances\": " << result.instances << ", \"solved\": " << result.solved
+        << ", \"checksum\": " << result.checksum
+        << ", \"nodes_expanded\": " << result.expanded << ", \"nodes_generated\": " << result.generated
+        << ", \"calls_per_rep\": " << calls
+        << ",\n     \"seconds\": ";
+    seconds.writeJson(out);
+    out << ",\n     \"nodes_per_sec\": ";
+    rates.writeJson(out);
+    out << ",\n     \"peak_rss_bytes\": " << peakRss;
+    if (result.profile.expanded > 0)
+    {
+        out << ",\n     \"profile\": ";
+        result.profile.writeJson(out, bench.solver.c_str());
+    }
+    out << "}";
+}
+
+// Usage: SearchBenchmark [--reps n] [--filter text] [--korf all | --korf first last]
+//                        [--pdb file] [--out file] [--list]
+// Every case matching the filter (a substring of "suite/solver") runs once
+// to warm up, then n times; seconds are per run of the whole suite. JSON
+// goes to stdout or --out, progress to stderr. Peak RSS is the process
+// high-water mark after the case, so run a single case per process
+// (--filter) when its own peak matters. Built with -DSEARCH_INSTRUMENTATION,
+// the Search<> profile of each case also carries phase times.
+int main(int argc, char *argv[])
+{
+    int repetitions = 5;
+    string filter;
+    string outPath;
+    bool listOnly = false;
+    vector<int> korf(begin(KORF_QUICK), end(KORF_QUICK));
+    PatternDatabase database;
+    const PatternDatabase *pdb = nullptr;
+
+    for (int i = 1; i < argc; i++)
+    {
+        string arg = argv[i];
+        if (arg == "--reps" && i + 1 < argc)
+            repetitions = max(1, atoi(argv[++i]));
+        else if (arg == "--filter" && i + 1 < argc)
+            filter = argv[++i];
+        else if (arg == "--out" && i + 1 < argc)
+            outPath = argv[++i];
+        else if (arg == "--list")
+            listOnly = true;
+        else if (arg == "--korf" && i + 1 < argc)
+        {
+            int first = 1, last = KORF_INSTANCE_COUNT;
+            if (string(argv[i + 1]) == "all")
+                i++;
+            else if (i + 2 < argc)
+            {
+                first = max(1, atoi(argv[++i]));
+                last = min(KORF_INSTANCE_COUNT, atoi(argv[++i]));
+            }
+            korf.clear();
+            for (int k = first; k <= last; k++)
+            {
+                korf.push_back(k);
+            }
+        }
+        else if (arg == "--pdb" && i + 1 < argc)
+        {
+            if (!database.load(argv[++i]) || database.width() != 4)
+            {
+                cerr << "Could not load a 15-puzzle pattern database from " << argv[i] << endl;
+                return 1;
+            }
+            pdb = &database;
+        }
+        else
+        {
+            cerr << "Unknown argument " << arg << endl;
+            return 1;
+        }
+    }
+
+    vector<BenchmarkCase> cases;
+    addEightPuzzleCases(cases);
+    addKorfCases(cases, korf, pdb);
+    addQueensCases(cases);
+    addTicTacToeCases(cases);
+    addMnkCases(cases);
+
+    if (listOnly)
+    {
+        for (const BenchmarkCase &bench : cases)
+        {
+            cout << bench.suite << "/" << bench.solver << endl;
+        }
+        return 0;
+    }
+
+    ofstream file;
+    if (!outPath.empty())
+    {
+        file.open(outPath);
+        if (!file)
+        {
+            cerr << "Could not write " << outPath << endl;
+            return 1;
+        }
+    }
+    ostream &out = outPath.empty() ? cout : file;
+
+    out << "{\"benchmark\": \"search\", \"repetitions\": " << repetitions << ", \"warmup\": 1, \"cases\": [\n";
+    bool first = true;
+    bool consistent = true;
+    for (const BenchmarkCase &bench : cases)
+    {
+        string name = bench.suite + "/" + bench.solver;
+        if (name.find(filter) == string::npos)
+            continue;
+        // Cases shorter than MIN_REP_SECONDS are called several times per
+        // repetition so the clock resolution does not dominate
+        auto warmupStart = chrono::steady_clock::now();
+        RunResult warmup = bench.run();
+        double warmupSeconds = chrono::duration<double>(chrono::steady_clock::now() - warmupStart).count();
+        int calls = warmupSeconds >= MIN_REP_SECONDS ? 1 : int(min(1e6, MIN_REP_SECONDS / max(warmupSeconds, 1e-7)));
+
+        SampleStats seconds, rates;
+        for (int rep = 0; rep < repetitions; rep++)
+        {
+            auto start = chrono::steady_clock::now();
+            for (int call = 0; call < calls; call++)
+            {
+                RunResult result = bench.run();
+                if (result.checksum != warmup.checksum || result.generated != warmup.generated)
+                    consistent = false;
+            }
+            double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count() / calls;
+            seconds.add(elapsed);
+            rates.add(warmup.generated / max(elapsed, 1e-9));
+        }
+
+        if (!first)
+            out << ",\n";
+        first = false;
+        writeCase(out, bench, warmup, calls, seconds, rates, peakResidentBytes());
+        out.flush();
+        cerr << name << ": " << seconds.mean() << " s, " << rates.mean() << " nodes/sec" << endl;
+    }
+    out << "\n  ]}\n";
+
+    if (!consistent)
+        cerr << "Repetitions disagreed on nodes or results!" << endl;
+    return consistent ? 0 : 1;
+}
@@ -3,6 +3,10 @@
 #include <random>
 #include <ctime>
 #include <algorithm>
+#include <string>
+#include <chrono>
+#include <memory>
+#include "../Search_Common/ParallelRestarts.h"
 
 class PuzzleSolver
 {
@@ -10,9 +14,10 @@ private:
     std::vector<int> current_state;
     std::vector<int> goal_state;
     const int SIZE = 4; // For 4-puzzle (2x2 grid + empty tile)
+    bool verbose;       // print progress from hillClimbing
 
 public:
-    PuzzleSolver()
+    PuzzleSolver() : verbose(true)
     {
         // Initialize goal state (0 represents empty tile)
         goal_state = {1, 2, 3, 0};
@@ -89,6 +94,13 @@ public:
         std::shuffle(current_state.begin(), current_state.end(), gen);
     }
 
+    // Same, from the caller's generator
+    void randomizeState(Xoshiro256 &rng)
+    {
+        current_state = goal_state;
+        std::shuffle(current_state.begin(), current_state.end(), rng);
+    }
+
     // Print the puzzle state
     void printState()
     {
@@ -108,18 +120,30 @@ public:
 
     // Hill Climbing algorithm
     bool hillClimbing(int maxSteps = 1000)
+    {
+        return hillClimbing(maxSteps, []
+                            { return false; });
+    }
+
+    // Hill climbing that gives up as soon as cancelled() returns true
+    template <class Cancel>
+    bool hillClimbing(int maxSteps, Cancel cancelled)
     {
         int steps = 0;
         int current_value = calculateManhattanDistance(current_state);
 
-        std::cout << "Initial state with h = " << current_value << ":\n";
-        printState();
+        if (verbose)
+        {
+            std::cout << "Initial state with h = " << current_value << ":\n";
+            printState();
+        }
 
-        while (steps < maxSteps)
+        while (steps < maxSteps && !cancelled())
         {
             if (current_value == 0)
             {
-                std::cout << "\nSolution found in " << steps << " steps!\n";
+                if (verbose)
+                    std::cout << "\nSolution found in " << steps << " steps!\n";
                 return true;
             }
 
@@ -146,7 +170,8 @@ public:
             // If no better state found, we're stuck in local minimum
             if (!improved)
             {
-                std::cout << "\nStuck in local minimum with h = " << current_value << "\n";
+                if (verbose)
+                    std::cout << "\nStuck in local minimum with h = " << current_value << "\n";
                 return false;
             }
 
@@ -156,21 +181,82 @@ public:
             steps++;
 
             // Print progress every 100 steps
-            if (steps % 100 == 0)
+            if (verbose && steps % 100 == 0)
             {
                 std::cout << "\nStep " << steps << " with h = " << current_value << ":\n";
                 printState();
             }
         }
 
-        std::cout << "\nFailed to find solution in " << maxSteps << " steps.\n";
+        if (verbose && steps == maxSteps)
+            std::cout << "\nFailed to find solution in " << maxSteps << " steps.\n";
         return false;
     }
+
+    // Random-restart hill climbing on `threads` threads, each with its own
+    // quiet solver; the first successful restart in seed order wins (see
+    // ParallelRestarts.h), so a master seed always gives the same result.
+    // On success the solved state is copied here.
+    RestartResult parallelHillClimbing(int threads, uint64_t master, uint64_t maxRestarts)
+    {
+        threads = std::max(threads, 1);
+        std::vector<std::unique_ptr<PuzzleSolver>> solvers;
+        for (int id = 0; id < threads; id++)
+        {
+            solvers.emplace_back(new PuzzleSolver());
+            solvers.back()->verbose = false;
+        }
+        RestartResult result = runParallelRestarts(threads, master, maxRestarts,
+                                                   [&](Xoshiro256 &rng, int worker, const RestartCancel &cancelled)
+                                                   {
+            PuzzleSolver &own = *solvers[worker];
+            own.randomizeState(rng);
+            return own.hillClimbing(1000, cancelled); });
+        if (result.solved)
+            current_state = solvers[result.worker]->current_state;
+        return result;
+    }
 };
 
-int main()
+// Usage: FourPuzzleHillClimbing [--restarts [--threads t] [--trials r] [--seed s]]
+// --restarts runs parallel random-restart hill climbing r times (default
+// 100) on t threads (default: all cores) and reports how many restarts
+// the runs needed.
+int main(int argc, char *argv[])
 {
+    bool restarts = false;
+    int threads = std::max(1, int(std::thread::hardware_concurrency()));
+    int trials = 100;
+    uint64_t seed = uint64_t(time(0));
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg == "--restarts")
+            restarts = true;
+        else if (arg == "--threads" && i + 1 < argc)
+            threads = std::atoi(argv[++i]);
+        else if (arg == "--trials" && i + 1 < argc)
+            trials = std::atoi(argv[++i]);
+        else if (arg == "--seed" && i + 1 < argc)
+            seed = std::strtoull(argv[++i], nullptr, 10);
+    }
+
     PuzzleSolver solver;
+    if (restarts)
+    {
+        const uint64_t MAX_RESTARTS = 1000;
+        RestartHistogram histogram;
+        auto start = std::chrono::steady_clock::now();
+        for (int trial = 0; trial < trials; trial++)
+        {
+            histogram.add(solver.parallelHillClimbing(threads, Xoshiro256::stream(seed, trial), MAX_RESTARTS));
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "Parallel random-restart hill climbing on the 4-puzzle, " << trials << " runs on " << threads
+                  << " threads: " << seconds << " s\n";
+        histogram.print(std::cout);
+        return 0;
+    }
 
     std::cout << "4-Puzzle Solver using Hill Climbing\n";
     std::cout << "Goal State:\n";
@@ -0,0 +1,95 @@
+#ifndef BENCHMARK_STATS_H
+#define BENCHMARK_STATS_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h> // link with -lpsapi
+#else
+#include <sys/resource.h>
+#endif
+
+// Peak resident set size of this process so far, in bytes (0 if unknown).
+// It never goes down, so a case run in a fresh process gets its own peak.
+inline uint64_t peakResidentBytes()
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return counters.PeakWorkingSetSize;
+    return 0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+#ifdef __APPLE__
+    return uint64_t(usage.ru_maxrss); // bytes
+#else
+    return uint64_t(usage.ru_maxrss) * 1024; // kilobytes
+#endif
+#endif
+}
+
+// Summary of repeated measurements (sample standard deviation)
+struct SampleStats
+{
+    std::vector<double> samples;
+
+    void add(double value)
+    {
+        samples.push_back(value);
+    }
+
+    double mean() const
+    {
+        double sum = 0;
+        for (double value : samples)
+        {
+            sum += value;
+        }
+        return samples.empty() ? 0 : sum / samples.size();
+    }
+
+    double stddev() const
+    {
+        if (samples.size() < 2)
+            return 0;
+        double m = mean();
+        double sum = 0;
+        for (double value : samples)
+        {
+            sum += (value - m) * (value - m);
+        }
+        return std::sqrt(sum / (samples.size() - 1));
+    }
+
+    double min() const
+    {
+        return samples.empty() ? 0 : *std::min_element(samples.begin(), samples.end());
+    }
+
+    double max() const
+    {
+        return samples.empty() ? 0 : *std::max_element(samples.begin(), samples.end());
+    }
+
+    // {"mean": ..., "stddev": ..., "min": ..., "max": ..., "runs": [...]}
+    void writeJson(std::ostream &out) const
+    {
+        out << "{\"mean\": " << mean() << ", \"stddev\": " << stddev()
+            << ", \"min\": " << min() << ", \"max\": " << max() << ", \"runs\": [";
+        for (size_t i = 0; i < samples.size(); i++)
+        {
+            out << (i > 0 ? ", " : "") << samples[i];
+        }
+        out << "]}";
+    }
+};
+
+#endif
@@ -0,0 +1,353 @@
+#ifndef BITBOARD_QUEENS_H
+#define BITBOARD_QUEENS_H
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "WorkStealingPool.h"
+#include "QueensSymmetry.h"
+
+// N-Queens by bitmask backtracking, rows filled top to bottom. Bit c of
+// `columns` is set when column c is taken; `left` and `right` hold the
+// squares of the current row attacked along each diagonal, and shift by one
+// per row. The free squares of a row are ~(columns | left | right), and the
+// lowest set bit is tried first, so solutions come out in the same order as
+// a left-to-right DFS. Boards up to 32 x 32.
+class BitboardQueens
+{
+public:
+    static const int MAX_SIZE = 32;
+
+    // A partial board: masks after `row` queens, and how many solutions
+    // each solution below it stands for (2 when its mirror is skipped)
+    struct Prefix
+    {
+        uint32_t columns, left, right;
+        int row;
+        int weight;
+    };
+
+private:
+    int n;
+    uint32_t full; // n low bits set
+    uint64_t placements;
+    size_t subproblems;
+
+    template <class Visit>
+    bool visitFrom(int row, uint32_t columns, uint32_t left, uint32_t right, int *queens, uint64_t &found, Visit &visit)
+    {
+        if (row == n)
+        {
+            found++;
+            return visit(static_cast<const int *>(queens));
+        }
+        uint32_t free = ~(columns | left | right) & full;
+        while (free != 0)
+        {
+            uint32_t bit = free & (0u - free);
+            free ^= bit;
+            placements++;
+            queens[row] = __builtin_ctz(bit);
+            if (!visitFrom(row + 1, columns | bit, (left | bit) << 1, (right | bit) >> 1, queens, found, visit))
+                return false;
+        }
+        return true;
+    }
+
+    // visitFrom restricted to allowed[row] on every row, visiting only the
+    // canonical solutions, with their multiplicity
+    template <class Visit>
+    bool visitFundamentalFrom(int row, uint32_t columns, uint32_t left, uint32_t right, const uint32_t *allowed,
+                              int *queens, uint64_t &found, Visit &visit)
+    {
+        if (row == n)
+        {
+            int multiplicity = queensMultiplicity(queens, n);
+            if (multiplicity == 0)
+                return true;
+            found++;
+            return visit(static_cast<const int *>(queens), multiplicity);
+        }
+        uint32_t free = ~(columns | left | right) & allowed[row];
+        while (free != 0)
+        {
+            uint32_t bit = free & (0u - free);
+            free ^= bit;
+            placements++;
+            queens[row] = __builtin_ctz(bit);
+            if (!visitFundamentalFrom(row + 1, columns | bit, (left | bit) << 1, (right | bit) >> 1, allowed, queens, found, visit))
+                return false;
+        }
+        return true;
+    }
+
+    // Masks of one row on countFrom's stack
+    struct Frame
+    {
+        uint32_t columns, left, right, free;
+    };
+
+    // Solutions below a partial board with `row` queens placed. Iterative,
+    // on a fixed stack: a row is only pushed if it has a free square, and
+    // the last row is not pushed at all, since any free square there
+    // completes a solution.
+    uint64_t countFrom(int row, uint32_t columns, uint32_t left, uint32_t right)
+    {
+        if (row == n)
+            return 1;
+        Frame stack[MAX_SIZE + 1];
+        uint64_t solutions = 0;
+        int base = row;
+        stack[row] = {columns, left, right, ~(columns | left | right) & full};
+        while (row >= base)
+        {
+            Frame &frame = stack[row];
+            if (frame.free == 0)
+            {
+                row--;
+                continue;
+            }
+            uint32_t bit = frame.free & (0u - frame.free);
+            frame.free ^= bit;
+            placements++;
+            if (row == n - 1)
+            {
+                solutions++;
+                continue;
+            }
+
+            uint32_t nextColumns = frame.columns | bit;
+            uint32_t nextLeft = (frame.left | bit) << 1;
+            uint32_t nextRight = (frame.right | bit) >> 1;
+            uint32_t nextFree = ~(nextColumns | nextLeft | nextRight) & full;
+            if (row + 1 == n - 1)
+            {
+                // At most one free square is left in the last row
+                placements += nextFree != 0;
+                solutions += nextFree != 0;
+            }
+            else if (nextFree != 0)
+            {
+                stack[++row] = {nextColumns, nextLeft, nextRight, nextFree};
+            }
+        }
+        return solutions;
+    }
+
+    void extend(const Prefix &prefix, int depth, std::vector<Prefix> &out) const
+    {
+        if (prefix.row >= depth || prefix.row == n)
+        {
+            out.push_back(prefix);
+            return;
+        }
+        for (uint32_t free = ~(prefix.columns | prefix.left | prefix.right) & full; free != 0; free &= free - 1)
+        {
+            uint32_t bit = free & (0u - free);
+            extend({prefix.columns | bit, (prefix.left | bit) << 1, (prefix.right | bit) >> 1, prefix.row + 1, prefix.weight},
+                   depth, out);
+        }
+    }
+
+public:
+    explicit BitboardQueens(int size)
+        : n(size), full(size >= 32 ? UINT32_MAX : (uint32_t(1) << size) - 1), placements(0), subproblems(0) {}
+
+    int size() const
+    {
+        return n;
+    }
+
+    // Partial boards with `depth` queens placed (at least one, two below a
+    // middle first queen) whose subtrees hold every solution once, after
+    // weights. A board and its mirror image are both solutions or both not,
+    // so only first-row queens in the left half are expanded, with weight 2.
+    // With n odd, a first queen in the middle column is expanded with the
+    // second-row queen in the left half.
+    std::vector<Prefix> prefixes(int depth) const
+    {
+        std::vector<Prefix> out;
+        if (n <= 1)
+        {
+            out.push_back({0, 0, 0, 0, 1});
+            return out;
+        }
+        uint32_t leftHalf = (uint32_t(1) << (n / 2)) - 1;
+        for (uint32_t free = leftHalf; free != 0; free &= free - 1)
+        {
+            uint32_t bit = free & (0u - free);
+            extend({bit, bit << 1, bit >> 1, 1, 2}, depth, out);
+        }
+        if (n % 2 == 1)
+        {
+            uint32_t middle = uint32_t(1) << (n / 2);
+            for (uint32_t free = ~(middle | middle << 1 | middle >> 1) & leftHalf; free != 0; free &= free - 1)
+            {
+                uint32_t bit = free & (0u - free);
+                extend({middle | bit, (middle << 1 | bit) << 1, (middle >> 1 | bit) >> 1, 2, 2}, depth, out);
+            }
+        }
+        return out;
+    }
+
+    // Solutions below one prefix, not yet multiplied by its weight
+    uint64_t countBelow(const Prefix &prefix)
+    {
+        return countFrom(prefix.row, prefix.columns, prefix.left, prefix.right);
+    }
+
+    // Number of solutions; nothing is stored
+    uint64_t count()
+    {
+        placements = 0;
+        uint64_t solutions = 0;
+        for (const Prefix &prefix : prefixes(1))
+        {
+            solutions += prefix.weight * countBelow(prefix);
+        }
+        return solutions;
+    }
+
+    // count() split into the subtrees below prefixes(prefixDepth), run on a
+    // work-stealing pool. Each task counts on its worker's own stack and adds
+    // to that worker's tally, which sits on its own cache line; the tallies
+    // are summed at the end. prefixDepth <= 0 picks the shallowest depth
+    // giving at least 64 tasks per thread.
+    uint64_t countParallel(int threadCount, int prefixDepth = 0)
+    {
+        struct alignas(64) Tally
+        {
+            uint64_t solutions = 0;
+            uint64_t placements = 0;
+        };
+
+        threadCount = std::max(threadCount, 1);
+        std::vector<Prefix> tasks;
+        if (prefixDepth > 0)
+            tasks = prefixes(prefixDepth);
+        for (int depth = 1; prefixDepth <= 0 && depth <= n; depth++)
+        {
+            tasks = prefixes(depth);
+            if (tasks.size() >= 64 * size_t(threadCount))
+                break;
+        }
+
+        std::vector<Tally> tallies(threadCount);
+        runWorkStealing(tasks.size(), threadCount, [&](size_t task, int worker)
+                        {
+            BitboardQueens local(n);
+            uint64_t below = local.countBelow(tasks[task]);
+            tallies[worker].solutions += tasks[task].weight * below;
+            tallies[worker].placements += local.placements; });
+
+        uint64_t solutions = 0;
+        placements = 0;
+        for (const Tally &tally : tallies)
+        {
+            solutions += tally.solutions;
+            placements += tally.placements;
+        }
+        subproblems = tasks.size();
+        return solutions;
+    }
+
+    // Subproblems the last countParallel() split the search into
+    size_t subproblemCount() const
+    {
+        return subproblems;
+    }
+
+    // Calls visit(queens) for each solution, where queens[row] is the
+    // column of that row's queen. visit returns false to stop early.
+    // Returns the number of solutions visited.
+    template <class Visit>
+    uint64_t forEachSolution(Visit visit)
+    {
+        placements = 0;
+        uint64_t found = 0;
+        int queens[MAX_SIZE];
+        visitFrom(0, 0, 0, 0, queens, found, visit);
+        return found;
+    }
+
+    // Calls visit(queens, multiplicity) once per fundamental solution: the
+    // canonical member of each class of solutions equal under rotation and
+    // reflection, multiplicity being the size of the class (8, 4 or 2).
+    // Returns the number of fundamental solutions visited.
+    //
+    // The canonical member has the smallest first-row column c of all its
+    // images, and the first rows of the images hold the queens of the four
+    // edges read from either end. So only c <= (n - 1) / 2 is tried, the edge
+    // columns are closed on rows nearer than c to the top or bottom, and the
+    // last row keeps its queen at least c from either corner. A corner queen
+    // (c = 0) gets its own rule below. Remaining ties are settled at the
+    // leaves.
+    template <class Visit>
+    uint64_t forEachFundamentalSolution(Visit visit)
+    {
+        placements = 0;
+        uint64_t found = 0;
+        int queens[MAX_SIZE];
+        uint32_t allowed[MAX_SIZE];
+        uint32_t edges = 1 | uint32_t(1) << (n - 1);
+        for (int first = 0; first <= (n - 1) / 2; first++)
+        {
+            for (int row = 0; row < n; row++)
+            {
+                allowed[row] = row < first || row > n - 1 - first ? full & ~edges : full;
+            }
+            allowed[n - 1] &= full >> first & full << first;
+
+            uint32_t bit = uint32_t(1) << first;
+            placements++;
+            queens[0] = first;
+            if (first > 0 || n < 3)
+            {
+                if (!visitFundamentalFrom(1, bit, bit << 1, bit >> 1, allowed, queens, found, visit))
+                    break;
+                continue;
+            }
+
+            // Corner queen: only the transpose can tie, and its second
+            // entry is the row of the queen in column 1. So with the row-1
+            // queen on column k, column 1 is closed on rows 2 .. k - 1.
+            bool stopped = false;
+            for (uint32_t free = ~(bit | bit << 1) & full; free != 0 && !stopped; free &= free - 1)
+            {
+                uint32_t second = free & (0u - free);
+                int k = __builtin_ctz(second);
+                for (int row = 2; row < n; row++)
+                {
+                    allowed[row] = row < k ? full & ~uint32_t(2) : full;
+                }
+                placements++;
+                queens[1] = k;
+                stopped = !visitFundamentalFrom(2, bit | second, (bit << 1 | second) << 1, (bit >> 1 | second) >> 1,
+                                                allowed, queens, found, visit);
+            }
+            if (stopped)
+                break;
+        }
+        return found;
+    }
+
+    // Fundamental solutions, and in `total` all solutions as the sum of
+    // their multiplicities
+    uint64_t countFundamental(uint64_t &total)
+    {
+        total = 0;
+        return forEachFundamentalSolution([&](const int *, int multiplicity)
+                                          {
+            total += multiplicity;
+            return true; });
+    }
+
+    // Queens placed by the last count(), countParallel() or forEachSolution();
+    // the counts only place queens below their prefixes
+    uint64_t nodesGenerated() const
+    {
+        return placements;
+    }
+};
+
+#endif
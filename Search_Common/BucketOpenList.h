@@ -0,0 +1,91 @@
+#ifndef BUCKET_OPEN_LIST_H
+#define BUCKET_OPEN_LIST_H
+
+#include <cstdint>
+#include <vector>
+
+// A* open list for small integer costs. buckets[f][h] is a LIFO stack of
+// node indices; pop takes the lowest f, breaking ties on the lowest h, so
+// nodes closest to the goal are expanded first. The nodes themselves live
+// in the caller's storage and are never moved.
+// Push is O(1). Pop is O(1) amortized while f never drops below the last
+// popped value, which holds for consistent heuristics.
+class BucketOpenList
+{
+private:
+    std::vector<std::vector<std::vector<uint32_t>>> buckets;
+    int minF; // no node has a smaller f than this
+    int minH; // ...nor, at f == minF, a smaller h
+    size_t count;
+
+public:
+    // maxF and maxH are sizing hints; larger costs grow the table
+    BucketOpenList(int maxF = 64, int maxH = 64) : minF(0), minH(0), count(0)
+    {
+        buckets.resize(maxF + 1);
+        for (std::vector<std::vector<uint32_t>> &row : buckets)
+        {
+            row.resize(maxH + 1);
+        }
+    }
+
+    void push(uint32_t node, int f, int h)
+    {
+        if (f >= int(buckets.size()))
+            buckets.resize(f + 1);
+        if (h >= int(buckets[f].size()))
+            buckets[f].resize(h + 1);
+        buckets[f][h].push_back(node);
+
+        if (count == 0 || f < minF || (f == minF && h < minH))
+        {
+            minF = f;
+            minH = h;
+        }
+        count++;
+    }
+
+    // Removes and returns the best node; the list must not be empty
+    uint32_t pop()
+    {
+        while (minH >= int(buckets[minF].size()) || buckets[minF][minH].empty())
+        {
+            if (++minH >= int(buckets[minF].size()))
+            {
+                minF++;
+                minH = 0;
+            }
+        }
+        uint32_t node = buckets[minF][minH].back();
+        buckets[minF][minH].pop_back();
+        count--;
+        return node;
+    }
+
+    bool empty() const
+    {
+        return count == 0;
+    }
+
+    size_t size() const
+    {
+        return count;
+    }
+
+    // Empties every bucket but keeps their memory for the next search
+    void clear()
+    {
+        for (std::vector<std::vector<uint32_t>> &row : buckets)
+        {
+            for (std::vector<uint32_t> &bucket : row)
+            {
+                bucket.clear();
+            }
+        }
+        minF = 0;
+        minH = 0;
+        count = 0;
+    }
+};
+
+#endif
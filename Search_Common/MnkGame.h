@@ -0,0 +1,548 @@
+#ifndef MNK_GAME_H
+#define MNK_GAME_H
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <vector>
+#include "Xoshiro.h"
+
+// m,n,k-games: two players take turns putting a stone on an empty cell of
+// an m x n board (m columns, n rows), and the first to get k in a row,
+// column or diagonal wins. Tic-tac-toe is 3,3,3; gomoku is 15,15,5.
+//
+// Each player's stones are a bitboard. Every run of k cells in a line is a
+// window, and the game keeps how many stones each player has in each one,
+// so a move touches only the windows through its cell (at most 4k). That
+// gives win detection (a window reaching k) and the evaluation for free:
+// like calculateHeuristic in A_Star_TicTacToe, a window scores for a
+// player when it holds their stones and none of the opponent's, the more
+// stones the more (4^(c-1) for c stones), and the position's score is the
+// sum, kept up to date move by move. Windows one stone short of k with no
+// opposing stone are threats, counted per player.
+
+const int MNK_MAX_SIDE = 19;
+const int MNK_MAX_CELLS = MNK_MAX_SIDE * MNK_MAX_SIDE;
+const int MNK_MAX_K = 8;
+
+// One bit per cell
+struct MnkBits
+{
+    static const int WORDS = (MNK_MAX_CELLS + 63) / 64;
+    uint64_t words[WORDS];
+
+    MnkBits() : words() {}
+
+    bool test(int cell) const
+    {
+        return words[cell >> 6] >> (cell & 63) & 1;
+    }
+
+    void set(int cell)
+    {
+        words[cell >> 6] |= uint64_t(1) << (cell & 63);
+    }
+
+    void reset(int cell)
+    {
+        words[cell >> 6] &= ~(uint64_t(1) << (cell & 63));
+    }
+};
+
+class MnkGame
+{
+public:
+    static const int NONE = -1; // no winner yet
+
+private:
+    int m, n, k, cells;
+    int radius; // moves considered: empty cells this close to a stone, 0 = all
+    MnkBits stones[2];
+    std::vector<int> windowCells;  // k cells per window
+    std::vector<int> windowStart;  // windows through cell c are
+    std::vector<int> cellWindows;  // cellWindows[windowStart[c] .. windowStart[c + 1])
+    std::vector<uint8_t> counts;   // stones per window and player: counts[2 w + p]
+    std::vector<int> nearStart;    // cells within `radius` of cell c are
+    std::vector<int> nearCells;    // nearCells[nearStart[c] .. nearStart[c + 1])
+    std::vector<uint16_t> nearby;  // stones within `radius` of each cell
+    std::vector<uint64_t> zobrist; // key of a stone of player p on cell c: [2 c + p]
+    std::vector<int> played;       // moves so far, capacity reserved up front
+    int weight[MNK_MAX_K + 1];
+    uint64_t key;
+    int score;      // sum of window scores, first player's view
+    int threats[2]; // windows one stone short of k, per player
+    int winner;
+
+    // Score of window w, first player's view
+    int windowScore(int w) const
+    {
+        int first = counts[2 * w], second = counts[2 * w + 1];
+        if (second == 0)
+            return weight[first];
+        if (first == 0)
+            return -weight[second];
+        return 0;
+    }
+
+    int threatsOf(int w, int p) const
+    {
+        return counts[2 * w + p] == k - 1 && counts[2 * w + (1 - p)] == 0;
+    }
+
+    // Adds (sign 1) or removes (sign -1) a stone of p on cell
+    void update(int cell, int p, int sign)
+    {
+        for (int i = windowStart[cell]; i < windowStart[cell + 1]; i++)
+        {
+            int w = cellWindows[i];
+            score -= windowScore(w);
+            threats[0] -= threatsOf(w, 0);
+            threats[1] -= threatsOf(w, 1);
+            counts[2 * w + p] += sign;
+            score += windowScore(w);
+            threats[0] += threatsOf(w, 0);
+            threats[1] += threatsOf(w, 1);
+            if (counts[2 * w + p] == k)
+                winner = p;
+        }
+        for (int i = nearStart[cell]; i < nearStart[cell + 1]; i++)
+        {
+            nearby[nearCells[i]] += sign;
+        }
+    }
+
+public:
+    // Boards up to MNK_MAX_SIDE on a side, 2 <= k <= min(MNK_MAX_K,
+    // max(m, n)). `seed` draws the Zobrist keys.
+    MnkGame(int columns, int rows, int inARow, int moveRadius = 2, uint64_t seed = 1)
+        : m(columns), n(rows), k(inARow), cells(columns * rows), radius(moveRadius),
+          key(0), score(0), threats(), winner(NONE)
+    {
+        const int DIRECTIONS[4][2] = {{0, 1}, {1, 0}, {1, 1}, {1, -1}}; // (row, col) steps
+        std::vector<std::vector<int>> through(cells);
+        for (int row = 0; row < n; row++)
+        {
+            for (int col = 0; col < m; col++)
+            {
+                for (const int *step : DIRECTIONS)
+                {
+                    int endRow = row + step[0] * (k - 1), endCol = col + step[1] * (k - 1);
+                    if (endRow < 0 || endRow >= n || endCol < 0 || endCol >= m)
+                        continue;
+                    int w = int(windowCells.size()) / k;
+                    for (int i = 0; i < k; i++)
+                    {
+                        int cell = (row + step[0] * i) * m + col + step[1] * i;
+                        windowCells.push_back(cell);
+                        through[cell].push_back(w);
+                    }
+                }
+            }
+        }
+        for (int cell = 0; cell < cells; cell++)
+        {
+            windowStart.push_back(int(cellWindows.size()));
+            cellWindows.insert(cellWindows.end(), through[cell].begin(), through[cell].end());
+        }
+        windowStart.push_back(int(cellWindows.size()));
+        counts.assign(windowCells.size() / k * 2, 0);
+
+        for (int cell = 0; cell < cells; cell++)
+        {
+            nearStart.push_back(int(nearCells.size()));
+            int row = cell / m, col = cell % m;
+            for (int r = std::max(0, row - radius); r <= std::min(n - 1, row + radius) && radius > 0; r++)
+            {
+                for (int c = std::max(0, col - radius); c <= std::min(m - 1, col + radius); c++)
+                {
+                    if (r != row || c != col)
+                        nearCells.push_back(r * m + c);
+                }
+            }
+        }
+        nearStart.push_back(int(nearCells.size()));
+        nearby.assign(cells, 0);
+
+        Xoshiro256 rng(seed);
+        for (int i = 0; i < 2 * cells; i++)
+        {
+            zobrist.push_back(rng.next());
+        }
+        weight[0] = 0;
+        for (int c = 1; c <= MNK_MAX_K; c++)
+        {
+            weight[c] = c == 1 ? 1 : weight[c - 1] * 4;
+        }
+        played.reserve(cells);
+    }
+
+    int columns() const
+    {
+        return m;
+    }
+
+    int rows() const
+    {
+        return n;
+    }
+
+    int inARow() const
+    {
+        return k;
+    }
+
+    int cellCount() const
+    {
+        return cells;
+    }
+
+    // Player to move: 0 moves first
+    int toMove() const
+    {
+        return int(played.size() & 1);
+    }
+
+    int moveCount() const
+    {
+        return int(played.size());
+    }
+
+    bool isFull() const
+    {
+        return int(played.size()) == cells;
+    }
+
+    // Player who completed a line, or NONE; only the last move can have
+    int winnerOf() const
+    {
+        return winner;
+    }
+
+    // Player whose stone is on cell, or NONE
+    int at(int cell) const
+    {
+        return stones[0].test(cell) ? 0 : stones[1].test(cell) ? 1 : NONE;
+    }
+
+    uint64_t hash() const
+    {
+        return key;
+    }
+
+    // Windows player p can complete with one more stone
+    int threatCount(int p) const
+    {
+        return threats[p];
+    }
+
+    // Score from the side to move's view
+    int evaluate() const
+    {
+        return toMove() == 0 ? score : -score;
+    }
+
+    // Moves are only considered near stones, so with a radius the search
+    // does not see every move; exact results need radius 0
+    bool considersAllMoves() const
+    {
+        return radius == 0;
+    }
+
+    void play(int cell)
+    {
+        int p = toMove();
+        stones[p].set(cell);
+        key ^= zobrist[2 * cell + p];
+        update(cell, p, 1);
+        played.push_back(cell);
+    }
+
+    void undo()
+    {
+        int cell = played.back();
+        played.pop_back();
+        int p = toMove();
+        winner = NONE;
+        update(cell, p, -1);
+        key ^= zobrist[2 * cell + p];
+        stones[p].reset(cell);
+    }
+
+    // Writes the candidate moves into `out` (room for cellCount()) and
+    // returns how many: every empty cell with radius 0, else the empty
+    // cells near a stone, or the centre on an empty board
+    int generateMoves(int *out) const
+    {
+        int count = 0;
+        if (radius > 0 && played.empty())
+        {
+            out[count++] = (n / 2) * m + m / 2;
+            return count;
+        }
+        for (int cell = 0; cell < cells; cell++)
+        {
+            if (!stones[0].test(cell) && !stones[1].test(cell) && (radius == 0 || nearby[cell] > 0))
+                out[count++] = cell;
+        }
+        return count;
+    }
+};
+
+// Alpha-beta (negamax) over an MnkGame with iterative deepening and a
+// Zobrist-keyed transposition table. Moves are tried in the order: table
+// move, the two killer moves of the ply, then by history score (raised by
+// depth^2 whenever a move causes a cutoff). A side with a threat wins on
+// the spot, scored without searching.
+class MnkSearch
+{
+public:
+    static const int WIN = 1000000000; // a win at ply p scores WIN - p
+    static const int MAX_PLY = MNK_MAX_CELLS + 2;
+
+    struct Iteration
+    {
+        int depth;
+        int value; // for the player to move at the root
+        int move;
+        uint64_t nodes;
+        uint64_t tableHits;
+        double seconds;
+    };
+
+private:
+    enum Bound : uint8_t
+    {
+        BOUND_EXACT,
+        BOUND_LOWER,
+        BOUND_UPPER
+    };
+
+    struct Entry
+    {
+        uint64_t key;
+        int32_t value;
+        int16_t depth;
+        int16_t move;
+        uint8_t bound;
+    };
+
+    MnkGame &game;
+    std::vector<Entry> table;
+    uint64_t tableMask;
+    std::vector<int> moveBuffer;  // cellCount() moves per ply
+    std::vector<int> orderBuffer; // their ordering scores
+    std::vector<int> killers;     // two per ply
+    std::vector<int> history;     // per player and cell, below HISTORY_LIMIT
+    uint64_t nodes;
+    uint64_t tableHits;
+    std::chrono::steady_clock::time_point deadline;
+    bool timed;
+    bool stopped;
+    int rootMove; // best move of the last finished root search
+
+    // History scores carry over between searches; once one passes this the
+    // table is halved, keeping every score far under the killer and table
+    // move ranks (INT_MAX - 2 and up) and clear of overflow
+    static const int HISTORY_LIMIT = 1 << 24;
+
+    static bool isWinScore(int value)
+    {
+        return value >= WIN - MAX_PLY || value <= -(WIN - MAX_PLY);
+    }
+
+    // Win scores are stored relative to the node, not the root
+    static int toTable(int value, int ply)
+    {
+        return value >= WIN - MAX_PLY ? value + ply : value <= -(WIN - MAX_PLY) ? value - ply : value;
+    }
+
+    static int fromTable(int value, int ply)
+    {
+        return value >= WIN - MAX_PLY ? value - ply : value <= -(WIN - MAX_PLY) ? value + ply : value;
+    }
+
+    int search(int depth, int alpha, int beta, int ply)
+    {
+        nodes++;
+        if (timed && (nodes & 4095) == 0 && std::chrono::steady_clock::now() > deadline)
+            stopped = true;
+        if (stopped)
+            return 0;
+        if (game.winnerOf() != MnkGame::NONE)
+            return -(WIN - ply); // the previous move completed a line
+        if (game.isFull())
+            return 0;
+        if (game.threatCount(game.toMove()) > 0)
+            return WIN - (ply + 1);
+        if (depth <= 0)
+            return game.evaluate();
+
+        int alphaBefore = alpha;
+        Entry &entry = table[game.hash() & tableMask];
+        int tableMove = -1;
+        if (entry.key == game.hash())
+        {
+            tableHits++;
+            tableMove = entry.move;
+            if (entry.depth >= depth && ply > 0)
+            {
+                int value = fromTable(entry.value, ply);
+                if (entry.bound == BOUND_EXACT)
+                    return value;
+                if (entry.bound == BOUND_LOWER)
+                    alpha = std::max(alpha, value);
+                else
+                    beta = std::min(beta, value);
+                if (alpha >= beta)
+                    return value;
+            }
+        }
+
+        int cells = game.cellCount();
+        int player = game.toMove();
+        int *moves = &moveBuffer[size_t(ply) * cells];
+        int *order = &orderBuffer[size_t(ply) * cells];
+        int count = game.generateMoves(moves);
+        for (int i = 0; i < count; i++)
+        {
+            int move = moves[i];
+            order[i] = move == tableMove                ? INT_MAX
+                       : move == killers[2 * ply]     ? INT_MAX - 1
+                       : move == killers[2 * ply + 1] ? INT_MAX - 2
+                                                      : history[player * cells + move];
+        }
+
+        int best = -WIN - 1;
+        int bestMove = moves[0];
+        for (int i = 0; i < count; i++)
+        {
+            // Selection sort, one step per move tried: cutoffs come early
+            int pick = i;
+            for (int j = i + 1; j < count; j++)
+            {
+                if (order[j] > order[pick])
+                    pick = j;
+            }
+            std::swap(moves[i], moves[pick]);
+            std::swap(order[i], order[pick]);
+
+            int move = moves[i];
+            game.play(move);
+            int value = -search(depth - 1, -beta, -alpha, ply + 1);
+            game.undo();
+            if (stopped)
+                return 0;
+            if (value > best)
+            {
+                best = value;
+                bestMove = move;
+            }
+            if (value > alpha)
+                alpha = value;
+            if (alpha >= beta)
+            {
+                if (move != killers[2 * ply])
+                {
+                    killers[2 * ply + 1] = killers[2 * ply];
+                    killers[2 * ply] = move;
+                }
+                if ((history[player * cells + move] += depth * depth) > HISTORY_LIMIT)
+                {
+                    for (int &score : history)
+                    {
+                        score /= 2;
+                    }
+                }
+                break;
+            }
+        }
+
+        entry.key = game.hash();
+        entry.value = toTable(best, ply);
+        entry.depth = int16_t(depth);
+        entry.move = int16_t(bestMove);
+        entry.bound = best <= alphaBefore ? BOUND_UPPER : best >= beta ? BOUND_LOWER : BOUND_EXACT;
+        if (ply == 0)
+            rootMove = bestMove;
+        return best;
+    }
+
+public:
+    // 2^tableBits table entries
+    MnkSearch(MnkGame &g, int tableBits = 20)
+        : game(g), table(size_t(1) << tableBits), tableMask((uint64_t(1) << tableBits) - 1),
+          moveBuffer(size_t(MAX_PLY) * g.cellCount()), orderBuffer(size_t(MAX_PLY) * g.cellCount()),
+          killers(2 * MAX_PLY, -1), history(2 * g.cellCount(), 0), nodes(0), tableHits(0), timed(false), stopped(false),
+          rootMove(-1)
+    {
+    }
+
+    // Searches the current position 1, 2, ... plies deep until maxDepth,
+    // the time limit (milliseconds, <= 0 for none) runs out, or the result
+    // is exact: a forced win or loss, or a depth reaching the end of the
+    // game with every move considered. Calls report(iteration) after each
+    // finished depth and returns the last one; an interrupted depth is
+    // dropped. The table and history carry over between calls.
+    template <class Report>
+    Iteration iterativeDeepening(int maxDepth, double millis, Report report)
+    {
+        auto start = std::chrono::steady_clock::now();
+        timed = millis > 0;
+        deadline = start + std::chrono::microseconds(int64_t(millis * 1000));
+        stopped = false;
+        std::fill(killers.begin(), killers.end(), -1);
+
+        int remaining = game.cellCount() - game.moveCount();
+        Iteration last = {0, 0, -1, 0, 0, 0.0};
+        nodes = tableHits = 0;
+        for (int depth = 1; depth <= std::min(maxDepth, remaining); depth++)
+        {
+            rootMove = -1;
+            int value = search(depth, -WIN - 1, WIN + 1, 0);
+            if (stopped)
+                break;
+            int move = rootMove;
+            if (move < 0)
+            {
+                // Decided without a search (a win on the spot): any move
+                // that completes the threat, found by trying each
+                int moves[MNK_MAX_CELLS];
+                int count = game.generateMoves(moves);
+                for (int i = 0; i < count && move < 0; i++)
+                {
+                    game.play(moves[i]);
+                    if (game.winnerOf() != MnkGame::NONE)
+                        move = moves[i];
+                    game.undo();
+                }
+            }
+            last = {depth, value, move, nodes, tableHits,
+                    std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()};
+            report(last);
+            if (isWinScore(value) || (depth == remaining && game.considersAllMoves()))
+                break;
+        }
+        return last;
+    }
+
+    Iteration iterativeDeepening(int maxDepth, double millis)
+    {
+        return iterativeDeepening(maxDepth, millis, [](const Iteration &) {});
+    }
+
+    // Whether an iteration's value is a proven result, not an estimate
+    bool isExact(const Iteration &iteration) const
+    {
+        int remaining = game.cellCount() - game.moveCount();
+        return isWinScore(iteration.value) || (iteration.depth == remaining && game.considersAllMoves());
+    }
+
+    // +1 win, 0 draw, -1 loss for the player to move, for exact iterations
+    static int outcome(const Iteration &iteration)
+    {
+        return iteration.value >= WIN - MAX_PLY ? 1 : iteration.value <= -(WIN - MAX_PLY) ? -1 : 0;
+    }
+};
+
+#endif
@@ -0,0 +1,373 @@
+#ifndef MNK_MCTS_H
+#define MNK_MCTS_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "MnkGame.h"
+#include "Xoshiro.h"
+
+// Monte Carlo tree search for m,n,k-games, for boards too big for
+// MnkSearch to see the end of. Each playout walks down the tree by UCT,
+// adds the children of the leaf it stops at, finishes the game with random
+// moves and credits the result to every node on the way.
+//
+// Nodes come from a pool allocated once, up front: a node's children are
+// one block taken from the pool with an atomic counter, so building the
+// tree allocates nothing and never locks. Several threads can share one
+// tree (tree-parallel). A thread claims the right to expand a leaf with a
+// compare-and-swap and publishes the children with a release store; a
+// thread that loses the race plays out from the leaf instead of waiting.
+// A thread passing through a node counts a virtual loss there until its
+// playout comes back, which steers the other threads down different
+// lines. Alternatively each thread grows its own tree over its own share
+// of the pool (root-parallel), and the root visit counts are summed at the
+// end.
+//
+// Playouts run on each thread's copy of the game with play/undo, so win
+// detection is the game's window counts; a side holding a threat (k - 1
+// stones in an open window) is taken to win on the spot. Every thread
+// draws from its own Xoshiro256 stream.
+
+struct MctsNode
+{
+    static const uint8_t UNEXPANDED = 0, EXPANDING = 1, EXPANDED = 2;
+
+    std::atomic<int32_t> visits; // finished playouts plus virtual losses in flight
+    std::atomic<int32_t> score;  // half-points for the player who moved here: 2 a win, 1 a draw
+    std::atomic<uint8_t> state;
+    int32_t firstChild;          // children valid once state is EXPANDED
+    int32_t childCount;
+    int16_t move;                // cell played to reach the node
+
+    void init(int cell)
+    {
+        visits.store(0, std::memory_order_relaxed);
+        score.store(0, std::memory_order_relaxed);
+        state.store(UNEXPANDED, std::memory_order_relaxed);
+        firstChild = childCount = 0;
+        move = int16_t(cell);
+    }
+};
+
+// Fixed pool of nodes; node 0 is the root
+class MctsTree
+{
+private:
+    std::unique_ptr<MctsNode[]> nodes;
+    int capacity;
+    std::atomic<int> used;
+    std::atomic<bool> exhausted;
+
+public:
+    explicit MctsTree(int size) : nodes(new MctsNode[std::max(size, 1)]), capacity(std::max(size, 1))
+    {
+        reset();
+    }
+
+    // Back to a lone root; nothing is freed or allocated
+    void reset()
+    {
+        used.store(1);
+        exhausted.store(false);
+        nodes[0].init(-1);
+    }
+
+    MctsNode &operator[](int index)
+    {
+        return nodes[index];
+    }
+
+    // First of `count` consecutive nodes, or -1 once the pool is spent
+    int allocate(int count)
+    {
+        int first = used.fetch_add(count, std::memory_order_relaxed);
+        if (first + count > capacity)
+        {
+            exhausted.store(true, std::memory_order_relaxed);
+            return -1;
+        }
+        return first;
+    }
+
+    bool isExhausted() const
+    {
+        return exhausted.load(std::memory_order_relaxed);
+    }
+
+    int size() const
+    {
+        return std::min(used.load(), capacity);
+    }
+};
+
+class MnkMcts
+{
+public:
+    struct Settings
+    {
+        int threads = 1;
+        bool rootParallel = false;  // a tree per thread instead of one shared tree
+        double millis = 1000;       // time per search
+        uint64_t maxPlayouts = 0;   // 0 for no limit
+        int poolNodes = 1 << 21;    // shared among the trees
+        double exploration = 1.0;   // UCT constant
+        int virtualLoss = 3;
+        int expandAfter = 2;        // visits before a leaf gets children
+        uint64_t seed = 1;
+    };
+
+    struct MoveStat
+    {
+        int move;
+        int64_t visits;
+        double winRate; // for the player to move at the root
+    };
+
+    struct Result
+    {
+        int move = -1;
+        uint64_t playouts = 0;
+        double seconds = 0;
+        int nodes = 0;
+        std::vector<MoveStat> moves; // most visited first
+
+        double playoutsPerSecond() const
+        {
+            return seconds > 0 ? playouts / seconds : 0;
+        }
+    };
+
+private:
+    Settings settings;
+    std::vector<std::unique_ptr<MctsTree>> trees;
+    uint64_t searches = 0;
+
+    struct Shared
+    {
+        std::atomic<uint64_t> playouts{0};
+        std::atomic<bool> stop{false};
+        std::chrono::steady_clock::time_point deadline;
+    };
+
+    int selectChild(MctsTree &tree, const MctsNode &node) const
+    {
+        double logParent = std::log(double(std::max(1, node.visits.load(std::memory_order_relaxed))));
+        int best = node.firstChild;
+        double bestValue = -1;
+        for (int child = node.firstChild; child < node.firstChild + node.childCount; child++)
+        {
+            int visits = tree[child].visits.load(std::memory_order_relaxed);
+            if (visits == 0)
+                return child;
+            double value = tree[child].score.load(std::memory_order_relaxed) / (2.0 * visits) +
+                           settings.exploration * std::sqrt(logParent / visits);
+            if (value > bestValue)
+            {
+                bestValue = value;
+                best = child;
+            }
+        }
+        return best;
+    }
+
+    // Called by the thread that won node's EXPANDING state
+    static bool expand(MctsTree &tree, MctsNode &node, const MnkGame &game, int *moves)
+    {
+        int count = game.generateMoves(moves);
+        int first = tree.allocate(count);
+        if (first < 0)
+        {
+            node.state.store(MctsNode::UNEXPANDED, std::memory_order_relaxed);
+            return false;
+        }
+        for (int i = 0; i < count; i++)
+        {
+            tree[first + i].init(moves[i]);
+        }
+        node.firstChild = first;
+        node.childCount = count;
+        node.state.store(MctsNode::EXPANDED, std::memory_order_release);
+        return true;
+    }
+
+    // Random moves to the end of the game, then undone; returns the winner
+    // or MnkGame::NONE for a draw
+    static int playout(MnkGame &game, Xoshiro256 &rng, int *empties)
+    {
+        int count = 0;
+        for (int cell = 0; cell < game.cellCount(); cell++)
+        {
+            if (game.at(cell) == MnkGame::NONE)
+                empties[count++] = cell;
+        }
+        int played = 0, winner = game.winnerOf();
+        while (winner == MnkGame::NONE && count > 0)
+        {
+            if (game.threatCount(game.toMove()) > 0)
+            {
+                winner = game.toMove();
+                break;
+            }
+            int pick = int(rng.below(uint32_t(count)));
+            int cell = empties[pick];
+            empties[pick] = empties[--count];
+            game.play(cell);
+            played++;
+            winner = game.winnerOf();
+        }
+        for (; played > 0; played--)
+        {
+            game.undo();
+        }
+        return winner;
+    }
+
+    uint64_t work(MctsTree &tree, MnkGame game, Xoshiro256 rng, Shared &shared) const
+    {
+        std::vector<int> moves(game.cellCount()), empties(game.cellCount()), path;
+        path.reserve(game.cellCount() + 1);
+        int rootPlayer = game.toMove();
+        int loss = settings.virtualLoss;
+        uint64_t done = 0;
+        while (!shared.stop.load(std::memory_order_relaxed))
+        {
+            if ((done & 15) == 0 && std::chrono::steady_clock::now() > shared.deadline)
+                break;
+            if (settings.maxPlayouts > 0 && shared.playouts.fetch_add(1, std::memory_order_relaxed) >= settings.maxPlayouts)
+                break;
+
+            // Selection and expansion
+            int index = 0;
+            path.clear();
+            path.push_back(0);
+            tree[0].visits.fetch_add(loss, std::memory_order_relaxed);
+            while (game.winnerOf() == MnkGame::NONE && !game.isFull())
+            {
+                MctsNode &node = tree[index];
+                uint8_t state = node.state.load(std::memory_order_acquire);
+                if (state == MctsNode::UNEXPANDED && !tree.isExhausted() &&
+                    (index == 0 || node.visits.load(std::memory_order_relaxed) >= settings.expandAfter + loss))
+                {
+                    uint8_t expected = MctsNode::UNEXPANDED;
+                    if (node.state.compare_exchange_strong(expected, MctsNode::EXPANDING, std::memory_order_acq_rel) &&
+                        expand(tree, node, game, moves.data()))
+                        state = MctsNode::EXPANDED;
+                }
+                if (state != MctsNode::EXPANDED)
+                    break;
+                index = selectChild(tree, node);
+                tree[index].visits.fetch_add(loss, std::memory_order_relaxed);
+                game.play(tree[index].move);
+                path.push_back(index);
+            }
+
+            int winner = playout(game, rng, empties.data());
+
+            // Back up: path[i] was reached by a move of the player to move
+            // i - 1 plies below the root
+            for (size_t i = 0; i < path.size(); i++)
+            {
+                MctsNode &node = tree[path[i]];
+                int mover = (rootPlayer + int(i) + 1) & 1;
+                node.score.fetch_add(winner == MnkGame::NONE ? 1 : winner == mover ? 2 : 0, std::memory_order_relaxed);
+                node.visits.fetch_add(1 - loss, std::memory_order_relaxed);
+            }
+            for (size_t i = 1; i < path.size(); i++)
+            {
+                game.undo();
+            }
+            done++;
+        }
+        shared.stop.store(true, std::memory_order_relaxed);
+        return done;
+    }
+
+public:
+    // Allocates the whole node pool
+    explicit MnkMcts(const Settings &s) : settings(s)
+    {
+        settings.threads = std::max(settings.threads, 1);
+        int treeCount = settings.rootParallel ? settings.threads : 1;
+        for (int i = 0; i < treeCount; i++)
+        {
+            trees.emplace_back(new MctsTree(settings.poolNodes / treeCount));
+        }
+    }
+
+    const Settings &config() const
+    {
+        return settings;
+    }
+
+    // Searches `position` (not over) and returns the most visited move. The
+    // trees start afresh each call; the pool is reused.
+    Result search(const MnkGame &position)
+    {
+        auto start = std::chrono::steady_clock::now();
+        Shared shared;
+        shared.deadline = start + std::chrono::microseconds(int64_t(settings.millis * 1000));
+        for (auto &tree : trees)
+        {
+            tree->reset();
+        }
+
+        std::vector<uint64_t> playouts(settings.threads, 0);
+        uint64_t base = searches++ * uint64_t(settings.threads);
+        auto worker = [&](int id)
+        {
+            MctsTree &tree = *trees[settings.rootParallel ? id : 0];
+            playouts[id] = work(tree, position, Xoshiro256(Xoshiro256::stream(settings.seed, base + id)), shared);
+        };
+        std::vector<std::thread> threads;
+        for (int id = 1; id < settings.threads; id++)
+        {
+            threads.emplace_back(worker, id);
+        }
+        worker(0);
+        for (std::thread &thread : threads)
+        {
+            thread.join();
+        }
+
+        Result result;
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        for (uint64_t count : playouts)
+        {
+            result.playouts += count;
+        }
+
+        // Root children, summed over the trees (all trees expand the root
+        // with the same move list)
+        std::vector<int64_t> visits(position.cellCount(), 0), score(position.cellCount(), 0);
+        for (auto &tree : trees)
+        {
+            result.nodes += tree->size();
+            MctsNode &root = (*tree)[0];
+            if (root.state.load(std::memory_order_acquire) != MctsNode::EXPANDED)
+                continue;
+            for (int child = root.firstChild; child < root.firstChild + root.childCount; child++)
+            {
+                visits[(*tree)[child].move] += (*tree)[child].visits.load();
+                score[(*tree)[child].move] += (*tree)[child].score.load();
+            }
+        }
+        for (int cell = 0; cell < position.cellCount(); cell++)
+        {
+            if (visits[cell] > 0)
+                result.moves.push_back({cell, visits[cell], score[cell] / (2.0 * visits[cell])});
+        }
+        std::stable_sort(result.moves.begin(), result.moves.end(), [](const MoveStat &a, const MoveStat &b)
+                         { return a.visits > b.visits; });
+        if (!result.moves.empty())
+            result.move = result.moves[0].move;
+        return result;
+    }
+};
+
+#endif
@@ -0,0 +1,108 @@
+#ifndef NODE_ARENA_H
+#define NODE_ARENA_H
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+// Every node generated by one search, stored as parallel arrays: packed
+// state, g, parent index and the move that produced it. Nodes are named by
+// their 32-bit index, so open lists and parent links never hold pointers
+// and nothing is freed node by node; reset() drops a whole search at once
+// and keeps the capacity for the next one.
+template <class PackedState>
+class NodeArena
+{
+public:
+    static const uint32_t NO_PARENT = UINT32_MAX;
+    static const uint8_t NO_MOVE = 255;
+
+private:
+    std::vector<PackedState> states;
+    std::vector<uint32_t> gCosts; // 32 bits: depth-first paths can pass 65,535 moves
+    std::vector<uint32_t> parents;
+    std::vector<uint8_t> moves;
+
+public:
+    uint32_t add(const PackedState &state, int g, uint32_t parent = NO_PARENT, int move = NO_MOVE)
+    {
+        states.push_back(state);
+        gCosts.push_back(uint32_t(g));
+        parents.push_back(parent);
+        moves.push_back(move);
+        return uint32_t(states.size() - 1);
+    }
+
+    const PackedState &state(uint32_t node) const
+    {
+        return states[node];
+    }
+
+    int g(uint32_t node) const
+    {
+        return gCosts[node];
+    }
+
+    uint32_t parent(uint32_t node) const
+    {
+        return parents[node];
+    }
+
+    int move(uint32_t node) const
+    {
+        return moves[node];
+    }
+
+    // Nodes from the root down to `node`
+    std::vector<uint32_t> pathTo(uint32_t node) const
+    {
+        std::vector<uint32_t> path;
+        for (uint32_t n = node; n != NO_PARENT; n = parents[n])
+        {
+            path.push_back(n);
+        }
+        std::reverse(path.begin(), path.end());
+        return path;
+    }
+
+    // Moves from the root to `node`, in the order they were made
+    std::vector<int> movesTo(uint32_t node) const
+    {
+        std::vector<int> result;
+        for (uint32_t n = node; parents[n] != NO_PARENT; n = parents[n])
+        {
+            result.push_back(moves[n]);
+        }
+        std::reverse(result.begin(), result.end());
+        return result;
+    }
+
+    size_t size() const
+    {
+        return states.size();
+    }
+
+    void reset()
+    {
+        states.clear();
+        gCosts.clear();
+        parents.clear();
+        moves.clear();
+    }
+
+    void reserve(size_t nodes)
+    {
+        states.reserve(nodes);
+        gCosts.reserve(nodes);
+        parents.reserve(nodes);
+        moves.reserve(nodes);
+    }
+
+    size_t bytes() const
+    {
+        return states.capacity() * sizeof(PackedState) + gCosts.capacity() * sizeof(uint32_t) +
+               parents.capacity() * sizeof(uint32_t) + moves.capacity();
+    }
+};
+
+#endif
@@ -0,0 +1,171 @@
+#ifndef PACKED_PUZZLE_H
+#define PACKED_PUZZLE_H
+
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+// Moves of the blank tile. Two bits each, so a move also fits in a packed path.
+enum PuzzleMove
+{
+    MOVE_UP = 0,
+    MOVE_DOWN = 1,
+    MOVE_LEFT = 2,
+    MOVE_RIGHT = 3
+};
+
+const char PUZZLE_MOVE_NAMES[4] = {'U', 'D', 'L', 'R'};
+
+// Move letters with `separator` between them
+inline std::string movesToString(const std::vector<int> &moves, const char *separator = "")
+{
+    std::string result;
+    for (size_t i = 0; i < moves.size(); i++)
+    {
+        if (i > 0)
+            result += separator;
+        result += PUZZLE_MOVE_NAMES[moves[i]];
+    }
+    return result;
+}
+
+// Sliding-puzzle board packed into a single 64-bit word.
+// Cell c holds its tile in bits [4c, 4c + 4), the blank (0) included, and the
+// blank's cell index is kept in the top nibble so it never has to be searched.
+template <int W>
+struct PackedPuzzle
+{
+    static_assert(W >= 2 && W * W < 16, "tiles and blank position must fit in 64 bits");
+
+    static const int WIDTH = W;
+    static const int CELLS = W * W;
+    static const int BLANK_SHIFT = 60;
+
+    uint64_t word;
+
+    PackedPuzzle() : word(0) {}
+    explicit PackedPuzzle(uint64_t w) : word(w) {}
+
+    int blank() const
+    {
+        return int(word >> BLANK_SHIFT);
+    }
+
+    int tileAt(int cell) const
+    {
+        return int((word >> (4 * cell)) & 0xF);
+    }
+
+    // Cell the blank moves into, or -1 if the move leaves the board
+    static int targetCell(int blankCell, int move)
+    {
+        switch (move)
+        {
+        case MOVE_UP:
+            return blankCell >= W ? blankCell - W : -1;
+        case MOVE_DOWN:
+            return blankCell < CELLS - W ? blankCell + W : -1;
+        case MOVE_LEFT:
+            return blankCell % W != 0 ? blankCell - 1 : -1;
+        default:
+            return blankCell % W != W - 1 ? blankCell + 1 : -1;
+        }
+    }
+
+    // Slide the tile at `target` into the blank: one shift-and-mask swap.
+    // The blank's nibble is zero, so moving the tile is a single add/subtract.
+    PackedPuzzle movedTo(int target) const
+    {
+        uint64_t tile = (word >> (4 * target)) & 0xF;
+        uint64_t w = word & ~(uint64_t(0xF) << BLANK_SHIFT);
+        w += (tile << (4 * blank())) - (tile << (4 * target));
+        return PackedPuzzle(w | (uint64_t(target) << BLANK_SHIFT));
+    }
+
+    bool operator==(const PackedPuzzle &other) const
+    {
+        return word == other.word;
+    }
+
+    bool operator!=(const PackedPuzzle &other) const
+    {
+        return word != other.word;
+    }
+
+    // Goal layout used throughout the repo: 1 2 3 ... with the blank last
+    static PackedPuzzle goal()
+    {
+        uint64_t w = 0;
+        for (int cell = 0; cell < CELLS - 1; cell++)
+        {
+            w |= uint64_t(cell + 1) << (4 * cell);
+        }
+        return PackedPuzzle(w | (uint64_t(CELLS - 1) << BLANK_SHIFT));
+    }
+
+    bool isGoal() const
+    {
+        return word == goal().word;
+    }
+
+    // Sum of Manhattan distances of every tile from its goal cell
+    int manhattanDistance() const
+    {
+        int distance = 0;
+        for (int cell = 0; cell < CELLS; cell++)
+        {
+            int value = tileAt(cell);
+            if (value != 0)
+            {
+                int goalCell = value - 1;
+                distance += abs(cell / W - goalCell / W) + abs(cell % W - goalCell % W);
+            }
+        }
+        return distance;
+    }
+
+    static PackedPuzzle fromBoard(const std::vector<std::vector<int>> &board)
+    {
+        uint64_t w = 0;
+        for (int i = 0; i < W; i++)
+        {
+            for (int j = 0; j < W; j++)
+            {
+                w |= uint64_t(board[i][j]) << (4 * (i * W + j));
+                if (board[i][j] == 0)
+                {
+                    w |= uint64_t(i * W + j) << BLANK_SHIFT;
+                }
+            }
+        }
+        return PackedPuzzle(w);
+    }
+
+    // Cells in reading order, 0 for the blank
+    static PackedPuzzle fromCells(const int *cells)
+    {
+        uint64_t w = 0;
+        for (int cell = 0; cell < CELLS; cell++)
+        {
+            w |= uint64_t(cells[cell]) << (4 * cell);
+            if (cells[cell] == 0)
+            {
+                w |= uint64_t(cell) << BLANK_SHIFT;
+            }
+        }
+        return PackedPuzzle(w);
+    }
+
+    std::vector<std::vector<int>> toBoard() const
+    {
+        std::vector<std::vector<int>> board(W, std::vector<int>(W));
+        for (int cell = 0; cell < CELLS; cell++)
+        {
+            board[cell / W][cell % W] = tileAt(cell);
+        }
+        return board;
+    }
+};
+
+#endif
@@ -0,0 +1,99 @@
+#ifndef PARALLEL_LAYER_BFS_H
+#define PARALLEL_LAYER_BFS_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include "StateBitmap.h"
+
+// Level-synchronous breadth-first search over a ranked state space.
+// Each frontier layer is handed out to the worker threads in chunks, a
+// state is claimed with a fetch-or on the shared visited bitmap, and every
+// thread appends the states it claimed to its own buffer. Joining the
+// workers is the layer barrier; the buffers are then concatenated into
+// the next frontier. Nothing is locked and no state is queued twice.
+//
+// expand(state, emit) calls emit(successor, rank) for each successor; the
+// rank indexes the bitmap and the successor is what the next layer stores
+// (the two may be the same number). Returns the size of every layer.
+template <class Expand>
+std::vector<uint64_t> parallelLayerBfs(const std::vector<uint64_t> &roots, const std::vector<uint64_t> &rootRanks,
+                                       AtomicStateBitmap &visited, int threadCount, Expand expand)
+{
+    // Small enough to balance the load, large enough that the shared
+    // counter is touched rarely
+    const size_t CHUNK = 1024;
+
+    std::vector<uint64_t> frontier;
+    for (size_t i = 0; i < roots.size(); i++)
+    {
+        if (!visited.testAndSet(rootRanks[i]))
+            frontier.push_back(roots[i]);
+    }
+
+    threadCount = std::max(threadCount, 1);
+    std::vector<std::vector<uint64_t>> buffers(threadCount);
+    std::vector<uint64_t> layerSizes;
+    while (!frontier.empty())
+    {
+        layerSizes.push_back(frontier.size());
+        std::atomic<size_t> nextChunk(0);
+
+        auto worker = [&](int id)
+        {
+            // Work on a local vector so threads never write to neighbouring
+            // vector headers in `buffers`
+            std::vector<uint64_t> out;
+            out.swap(buffers[id]);
+            out.clear();
+            auto emit = [&](uint64_t successor, uint64_t rank)
+            {
+                if (!visited.testAndSet(rank))
+                    out.push_back(successor);
+            };
+            for (;;)
+            {
+                size_t begin = nextChunk.fetch_add(CHUNK, std::memory_order_relaxed);
+                if (begin >= frontier.size())
+                    break;
+                size_t end = std::min(begin + CHUNK, frontier.size());
+                for (size_t i = begin; i < end; i++)
+                {
+                    expand(frontier[i], emit);
+                }
+            }
+            buffers[id].swap(out);
+        };
+
+        std::vector<std::thread> threads;
+        for (int id = 1; id < threadCount; id++)
+        {
+            threads.emplace_back(worker, id);
+        }
+        worker(0);
+        for (std::thread &thread : threads)
+        {
+            thread.join();
+        }
+
+        size_t total = 0;
+        for (const std::vector<uint64_t> &buffer : buffers)
+        {
+            total += buffer.size();
+        }
+        frontier.resize(total);
+        size_t offset = 0;
+        for (const std::vector<uint64_t> &buffer : buffers)
+        {
+            if (!buffer.empty())
+                memcpy(frontier.data() + offset, buffer.data(), buffer.size() * sizeof(uint64_t));
+            offset += buffer.size();
+        }
+    }
+    return layerSizes;
+}
+
+#endif
@@ -0,0 +1,152 @@
+#ifndef PARALLEL_RESTARTS_H
+#define PARALLEL_RESTARTS_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <thread>
+#include <vector>
+#include "Xoshiro.h"
+
+// Random restarts of a local search spread over threads. Attempt i draws
+// from its own generator, seeded with Xoshiro256::stream(master, i), and
+// attempts are handed out in index order. When attempt i succeeds, every
+// attempt numbered above i is cancelled at once and none is started;
+// attempts below i run on, since one of them may still succeed. The
+// winner is therefore the lowest-numbered successful attempt, the same
+// one a single thread would find, whatever the timing.
+
+struct RestartResult
+{
+    bool solved = false;
+    uint64_t attempt = 0;  // index of the winning attempt
+    uint64_t started = 0;  // attempts begun, cancelled ones included
+    int worker = -1;       // thread that ran the winner
+};
+
+// Handed to each attempt; poll it between steps
+class RestartCancel
+{
+private:
+    const std::atomic<uint64_t> &best;
+    uint64_t index;
+
+public:
+    RestartCancel(const std::atomic<uint64_t> &b, uint64_t i) : best(b), index(i) {}
+
+    bool operator()() const
+    {
+        return best.load(std::memory_order_relaxed) < index;
+    }
+};
+
+// Calls attempt(rng, worker, cancel) -> bool for attempts 0, 1, ... up to
+// maxAttempts, on threadCount threads (the calling thread is worker 0),
+// until one returns true. `worker` lets an attempt reuse that thread's own
+// board.
+template <class Attempt>
+RestartResult runParallelRestarts(int threadCount, uint64_t master, uint64_t maxAttempts, Attempt attempt)
+{
+    threadCount = std::max(threadCount, 1);
+    std::atomic<uint64_t> next(0);
+    std::atomic<uint64_t> best(UINT64_MAX);
+    std::atomic<uint64_t> started(0);
+    // Lowest attempt each thread won, to tell afterwards who ran the winner
+    std::vector<uint64_t> wonBy(threadCount, UINT64_MAX);
+
+    auto worker = [&](int id)
+    {
+        Xoshiro256 rng;
+        for (;;)
+        {
+            uint64_t index = next.fetch_add(1);
+            if (index >= maxAttempts || index > best.load())
+                return;
+            started.fetch_add(1, std::memory_order_relaxed);
+            rng.reseed(Xoshiro256::stream(master, index));
+            if (!attempt(rng, id, RestartCancel(best, index)))
+                continue;
+            wonBy[id] = std::min(wonBy[id], index);
+            // Keep the lowest successful index
+            uint64_t seen = best.load();
+            while (index < seen && !best.compare_exchange_weak(seen, index))
+            {
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int id = 1; id < threadCount; id++)
+    {
+        threads.emplace_back(worker, id);
+    }
+    worker(0);
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+
+    RestartResult result;
+    result.solved = best.load() != UINT64_MAX;
+    result.attempt = result.solved ? best.load() : maxAttempts;
+    result.started = started.load();
+    for (int id = 0; id < threadCount && result.solved; id++)
+    {
+        if (wonBy[id] == result.attempt)
+            result.worker = id;
+    }
+    return result;
+}
+
+// Tally of how many restarts each run needed (the winning attempt's index,
+// so 0 when the first attempt succeeds)
+class RestartHistogram
+{
+private:
+    std::map<uint64_t, uint64_t> runs; // restarts -> number of runs
+    uint64_t failures = 0;
+
+public:
+    void add(const RestartResult &result)
+    {
+        if (result.solved)
+            runs[result.attempt]++;
+        else
+            failures++;
+    }
+
+    void print(std::ostream &out) const
+    {
+        uint64_t total = 0, sum = 0;
+        for (const auto &entry : runs)
+        {
+            total += entry.second;
+            sum += entry.first * entry.second;
+        }
+        out << "Restarts needed (runs):";
+        for (const auto &entry : runs)
+        {
+            out << " " << entry.first << " (" << entry.second << ")";
+        }
+        out << "\n";
+        if (total > 0)
+        {
+            uint64_t median = 0, seen = 0;
+            for (const auto &entry : runs)
+            {
+                seen += entry.second;
+                if (seen * 2 >= total)
+                {
+                    median = entry.first;
+                    break;
+                }
+            }
+            out << "Mean " << double(sum) / total << ", median " << median << ", max " << runs.rbegin()->first << ", ";
+        }
+        out << failures << " runs failed\n";
+    }
+};
+
+#endif
@@ -0,0 +1,116 @@
+#ifndef PATTERN_DATABASE_H
+#define PATTERN_DATABASE_H
+
+#include <cstdint>
+#include <cstring>
+#include "MappedFile.h"
+#include "PermutationRank.h"
+
+const int PDB_MAX_CELLS = 32;
+const int PDB_MAX_PATTERNS = 8;
+const int PDB_MAX_PATTERN_TILES = 12;
+const char PATTERN_DATABASE_MAGIC[4] = {'P', 'D', 'B', '1'};
+
+// On-disk layout of an additive disjoint pattern database: this header,
+// then one table per pattern at the recorded offset (64-byte aligned).
+// A table holds one byte per placement of the pattern's tiles, indexed by
+// rankPartialPermutation of their cells in the listed order, giving the
+// fewest moves of pattern tiles needed to bring them home. Moves of other
+// tiles cost nothing, so the tables of disjoint patterns can be added.
+struct PatternDatabaseHeader
+{
+    char magic[4];
+    uint32_t width;
+    uint32_t patternCount;
+    uint32_t reserved;
+    uint8_t goalCell[PDB_MAX_CELLS];  // goal cell of each tile, tile 0 is the blank
+    uint8_t patternOf[PDB_MAX_CELLS]; // pattern of each tile, 255 for the blank
+    struct
+    {
+        uint32_t tileCount;
+        uint8_t tiles[PDB_MAX_PATTERN_TILES];
+        uint64_t offset;
+        uint64_t entries;
+    } patterns[PDB_MAX_PATTERNS];
+};
+
+// Read-only view of a pattern database file, mapped so that every solver
+// process shares the page cache copy and nothing is regenerated at startup.
+class PatternDatabase
+{
+private:
+    MappedFile file;
+    PatternDatabaseHeader header;
+    const uint8_t *tables[PDB_MAX_PATTERNS];
+
+public:
+    PatternDatabase() : header() {}
+
+    bool load(const char *path)
+    {
+        if (!file.open(path) || file.size() < sizeof(PatternDatabaseHeader))
+            return false;
+
+        memcpy(&header, file.data(), sizeof(header));
+        if (memcmp(header.magic, PATTERN_DATABASE_MAGIC, 4) != 0 ||
+            header.width * header.width > uint32_t(PDB_MAX_CELLS) ||
+            header.patternCount > uint32_t(PDB_MAX_PATTERNS))
+            return false;
+
+        int cells = header.width * header.width;
+        for (uint32_t p = 0; p < header.patternCount; p++)
+        {
+            if (header.patterns[p].tileCount > uint32_t(PDB_MAX_PATTERN_TILES) ||
+                header.patterns[p].entries != partialPermutationCount(header.patterns[p].tileCount, cells) ||
+                header.patterns[p].offset + header.patterns[p].entries > file.size())
+                return false;
+            tables[p] = file.data() + header.patterns[p].offset;
+        }
+        return true;
+    }
+
+    int width() const
+    {
+        return header.width;
+    }
+
+    int patternCount() const
+    {
+        return header.patternCount;
+    }
+
+    int goalCell(int tile) const
+    {
+        return header.goalCell[tile];
+    }
+
+    int patternOf(int tile) const
+    {
+        return header.patternOf[tile] == 255 ? -1 : header.patternOf[tile];
+    }
+
+    // cellOf[tile] gives the current cell of every tile
+    int lookup(int pattern, const int *cellOf) const
+    {
+        int cells[PDB_MAX_PATTERN_TILES];
+        int count = header.patterns[pattern].tileCount;
+        for (int i = 0; i < count; i++)
+        {
+            cells[i] = cellOf[header.patterns[pattern].tiles[i]];
+        }
+        return tables[pattern][rankPartialPermutation(cells, count, header.width * header.width)];
+    }
+
+    // Sum over all patterns: the additive heuristic value of a board
+    int evaluate(const int *cellOf) const
+    {
+        int total = 0;
+        for (uint32_t p = 0; p < header.patternCount; p++)
+        {
+            total += lookup(p, cellOf);
+        }
+        return total;
+    }
+};
+
+#endif
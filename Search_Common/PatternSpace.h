@@ -0,0 +1,130 @@
+#ifndef PATTERN_SPACE_H
+#define PATTERN_SPACE_H
+
+#include <cstdint>
+#include <cstdlib>
+#include "PermutationRank.h"
+#include "PatternDatabase.h"
+
+// Abstract state space of a sliding puzzle pattern: where the pattern tiles
+// are, and which region of cells the blank can reach between them. Other
+// tiles are abstracted away, so only moves of pattern tiles cost anything.
+// A state is numbered placement * cells + the lowest cell of its blank
+// region, so a bitmap over size() states holds one bit per region.
+class PatternSpace
+{
+private:
+    int width;
+    int cells;
+    int count;
+    int tiles[PDB_MAX_PATTERN_TILES];
+    int goalCell[PDB_MAX_CELLS];
+    uint32_t board;
+    uint32_t notFirstColumn;
+    uint32_t notLastColumn;
+
+public:
+    PatternSpace(int width, const int *patternTiles, int tileCount, const int *goalCells)
+        : width(width), cells(width * width), count(tileCount), notFirstColumn(0), notLastColumn(0)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            tiles[i] = patternTiles[i];
+        }
+        for (int tile = 0; tile < cells; tile++)
+        {
+            goalCell[tile] = goalCells[tile];
+        }
+        board = cells == 32 ? ~0u : (1u << cells) - 1;
+        for (int cell = 0; cell < cells; cell++)
+        {
+            if (cell % width != 0)
+                notFirstColumn |= 1u << cell;
+            if (cell % width != width - 1)
+                notLastColumn |= 1u << cell;
+        }
+    }
+
+    uint64_t placements() const
+    {
+        return partialPermutationCount(count, cells);
+    }
+
+    uint64_t size() const
+    {
+        return placements() * cells;
+    }
+
+    int cellCount() const
+    {
+        return cells;
+    }
+
+    // Cells the blank can reach from `start` without crossing a pattern tile
+    uint32_t blankRegion(int start, uint32_t occupied) const
+    {
+        uint32_t free = board & ~occupied;
+        uint32_t region = 1u << start;
+        uint32_t previous = 0;
+        while (region != previous)
+        {
+            previous = region;
+            uint32_t grown = region | ((region << 1) & notFirstColumn) | ((region >> 1) & notLastColumn) |
+                             (region << width) | (region >> width);
+            region = grown & free;
+        }
+        return region;
+    }
+
+    // The goal placement with the blank in its goal region
+    uint64_t goalState() const
+    {
+        int positions[PDB_MAX_PATTERN_TILES];
+        uint32_t occupied = 0;
+        for (int i = 0; i < count; i++)
+        {
+            positions[i] = goalCell[tiles[i]];
+            occupied |= 1u << positions[i];
+        }
+        uint32_t region = blankRegion(goalCell[0], occupied);
+        return rankPartialPermutation(positions, count, cells) * cells + __builtin_ctz(region);
+    }
+
+    // Calls emit(next) for every state one pattern-tile move away: any
+    // pattern tile next to the blank region may slide into it
+    template <class Emit>
+    void expand(uint64_t state, Emit &&emit) const
+    {
+        uint64_t index = state / cells;
+        int blank = int(state % cells);
+
+        int cellsOfTiles[PDB_MAX_PATTERN_TILES];
+        unrankPartialPermutation(index, count, cells, cellsOfTiles);
+        uint32_t taken = 0;
+        for (int i = 0; i < count; i++)
+        {
+            taken |= 1u << cellsOfTiles[i];
+        }
+        uint32_t blankCells = blankRegion(blank, taken);
+
+        for (int i = 0; i < count; i++)
+        {
+            int from = cellsOfTiles[i];
+            for (uint32_t r = blankCells; r != 0; r &= r - 1)
+            {
+                int to = __builtin_ctz(r);
+                if (abs(to / width - from / width) + abs(to % width - from % width) != 1)
+                    continue;
+
+                cellsOfTiles[i] = to;
+                uint64_t nextIndex = rankPartialPermutation(cellsOfTiles, count, cells);
+                cellsOfTiles[i] = from;
+
+                uint32_t nextRegion = blankRegion(from, (taken & ~(1u << from)) | (1u << to));
+                emit(nextIndex * cells + __builtin_ctz(nextRegion));
+            }
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,175 @@
+#ifndef PERMUTATION_RANK_H
+#define PERMUTATION_RANK_H
+
+#include <cstdint>
+#include "PackedPuzzle.h"
+
+// Lexicographic (Lehmer code) rank of k distinct values drawn from 0..n-1,
+// n <= 32. Each digit counts the smaller values still unused, which is one
+// popcount against a bitmask of the values already seen, so ranking is O(k).
+// There are n! / (n - k)! ranks.
+inline uint64_t rankPartialPermutation(const int *values, int k, int n)
+{
+    uint64_t rank = 0;
+    uint32_t seen = 0;
+    for (int i = 0; i < k; i++)
+    {
+        int smallerUnused = values[i] - __builtin_popcount(seen & ((1u << values[i]) - 1));
+        rank = rank * (n - i) + smallerUnused;
+        seen |= 1u << values[i];
+    }
+    return rank;
+}
+
+// Inverse of rankPartialPermutation. Returns the Lehmer digit sum mod 2,
+// which for k == n is the parity of the permutation.
+inline int unrankPartialPermutation(uint64_t rank, int k, int n, int *values)
+{
+    int digits[32];
+    for (int i = k - 1; i >= 0; i--)
+    {
+        digits[i] = int(rank % (n - i));
+        rank /= (n - i);
+    }
+
+    int parity = 0;
+    uint32_t unused = n == 32 ? ~0u : (1u << n) - 1;
+    for (int i = 0; i < k; i++)
+    {
+        // Select the digits[i]-th remaining value
+        uint32_t mask = unused;
+        for (int j = 0; j < digits[i]; j++)
+        {
+            mask &= mask - 1;
+        }
+        values[i] = __builtin_ctz(mask);
+        unused &= ~(1u << values[i]);
+        parity ^= digits[i] & 1;
+    }
+    return parity;
+}
+
+// Full permutations of 0..n-1, n <= 16
+inline uint64_t rankPermutation(const int *perm, int n)
+{
+    return rankPartialPermutation(perm, n, n);
+}
+
+// Returns the parity of the permutation, which callers use to pick a solvable half
+inline int unrankPermutation(uint64_t rank, int n, int *perm)
+{
+    return unrankPartialPermutation(rank, n, n, perm);
+}
+
+// Parity of a permutation of 0..n-1: the Lehmer digit sum mod 2
+inline int permutationParity(const int *perm, int n)
+{
+    int parity = 0;
+    uint32_t seen = 0;
+    for (int i = 0; i < n; i++)
+    {
+        parity ^= (perm[i] - __builtin_popcount(seen & ((1u << perm[i]) - 1))) & 1;
+        seen |= 1u << perm[i];
+    }
+    return parity;
+}
+
+inline uint64_t factorial(int n)
+{
+    uint64_t result = 1;
+    for (int i = 2; i <= n; i++)
+    {
+        result *= i;
+    }
+    return result;
+}
+
+// Number of k-permutations of n values: n! / (n - k)!
+inline uint64_t partialPermutationCount(int k, int n)
+{
+    uint64_t result = 1;
+    for (int i = 0; i < k; i++)
+    {
+        result *= n - i;
+    }
+    return result;
+}
+
+// Perfect hash of the solvable half of a W x W sliding puzzle onto
+// [0, CELLS!/2). The tiles are ranked in reading order with the blank
+// skipped; permutations at Lehmer ranks 2k and 2k + 1 differ only by a swap
+// of the last two tiles, so exactly one of them is solvable for a given
+// blank cell and rank / 2 loses nothing.
+template <int W>
+struct PuzzleRanking
+{
+    typedef PackedPuzzle<W> Board;
+    static const int TILES = Board::CELLS - 1;
+
+    static uint64_t size()
+    {
+        return factorial(Board::CELLS) / 2;
+    }
+
+    // Vertical moves shift a tile past W - 1 others, so for even widths
+    // tile parity and the blank's row change together.
+    static int requiredParity(int blank)
+    {
+        return (W % 2 == 0) ? (W - 1 - blank / W) & 1 : 0;
+    }
+
+    // Tiles in reading order with the blank skipped, numbered from 0
+    static void tilesOf(const Board &board, int *tiles)
+    {
+        int count = 0;
+        for (int cell = 0; cell < Board::CELLS; cell++)
+        {
+            int value = board.tileAt(cell);
+            if (value != 0)
+            {
+                tiles[count++] = value - 1;
+            }
+        }
+    }
+
+    // Only boards in the goal's parity class have a rank
+    static bool isSolvable(const Board &board)
+    {
+        int tiles[Board::CELLS];
+        tilesOf(board, tiles);
+        return permutationParity(tiles, TILES) == requiredParity(board.blank());
+    }
+
+    static uint64_t rank(const Board &board)
+    {
+        int tiles[Board::CELLS];
+        tilesOf(board, tiles);
+        return (rankPermutation(tiles, TILES) >> 1) * Board::CELLS + board.blank();
+    }
+
+    static Board unrank(uint64_t index)
+    {
+        int blank = int(index % Board::CELLS);
+        int tiles[Board::CELLS];
+        int parity = unrankPermutation((index / Board::CELLS) << 1, TILES, tiles);
+
+        if (parity != requiredParity(blank))
+        {
+            int last = tiles[TILES - 1];
+            tiles[TILES - 1] = tiles[TILES - 2];
+            tiles[TILES - 2] = last;
+        }
+
+        uint64_t w = uint64_t(blank) << Board::BLANK_SHIFT;
+        for (int cell = 0, t = 0; cell < Board::CELLS; cell++)
+        {
+            if (cell != blank)
+            {
+                w |= uint64_t(tiles[t++] + 1) << (4 * cell);
+            }
+        }
+        return Board(w);
+    }
+};
+
+#endif
@@ -0,0 +1,95 @@
+#ifndef PUZZLE_DISTANCE_TABLE_H
+#define PUZZLE_DISTANCE_TABLE_H
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "MappedFile.h"
+#include "PackedPuzzle.h"
+#include "PermutationRank.h"
+
+// On-disk layout: this header followed by one nibble per solvable board,
+// indexed by PuzzleRanking<W>::rank (even ranks in the low nibble).
+// Each nibble holds the optimal distance to the goal modulo 16. The 8-puzzle
+// diameter is 31, but neighbours always differ by exactly one move, so
+// distance mod 16 is enough to tell the step towards the goal apart.
+struct DistanceTableHeader
+{
+    char magic[4];
+    uint32_t width;
+    uint64_t states;
+};
+
+const char DISTANCE_TABLE_MAGIC[4] = {'P', 'D', 'T', '1'};
+
+template <int W>
+class PuzzleDistanceTable
+{
+private:
+    typedef PackedPuzzle<W> Board;
+
+    MappedFile file;
+    const unsigned char *nibbles;
+
+public:
+    PuzzleDistanceTable() : nibbles(nullptr) {}
+
+    static size_t fileSize()
+    {
+        return sizeof(DistanceTableHeader) + (PuzzleRanking<W>::size() + 1) / 2;
+    }
+
+    // Maps the table read-only and checks it was built for this board size
+    bool load(const char *path)
+    {
+        nibbles = nullptr;
+        if (!file.open(path) || file.size() != fileSize())
+            return false;
+
+        DistanceTableHeader header;
+        memcpy(&header, file.data(), sizeof(header));
+        if (memcmp(header.magic, DISTANCE_TABLE_MAGIC, 4) != 0 ||
+            header.width != uint32_t(W) || header.states != PuzzleRanking<W>::size())
+            return false;
+
+        nibbles = file.data() + sizeof(DistanceTableHeader);
+        return true;
+    }
+
+    int distanceMod16(const Board &board) const
+    {
+        uint64_t index = PuzzleRanking<W>::rank(board);
+        return (nibbles[index >> 1] >> ((index & 1) * 4)) & 0xF;
+    }
+
+    // Steps greedily down the table: from a board at distance d some
+    // neighbour is at d - 1, and it is the only one whose nibble is one less.
+    // O(path length); returns false for boards that cannot reach the goal.
+    bool solve(Board board, std::vector<int> &moves) const
+    {
+        moves.clear();
+        if (!PuzzleRanking<W>::isSolvable(board))
+            return false;
+
+        while (!board.isGoal())
+        {
+            int closer = (distanceMod16(board) + 15) & 0xF;
+            bool stepped = false;
+            for (int move = 0; move < 4 && !stepped; move++)
+            {
+                int target = Board::targetCell(board.blank(), move);
+                if (target >= 0 && distanceMod16(board.movedTo(target)) == closer)
+                {
+                    board = board.movedTo(target);
+                    moves.push_back(move);
+                    stepped = true;
+                }
+            }
+            if (!stepped)
+                return false; // Corrupt table
+        }
+        return true;
+    }
+};
+
+#endif
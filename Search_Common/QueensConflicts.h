@@ -0,0 +1,108 @@
+#ifndef QUEENS_CONFLICTS_H
+#define QUEENS_CONFLICTS_H
+
+#include <algorithm>
+#include <vector>
+
+// Attacking pairs of a board with one queen per column, kept up to date as
+// queens move. Counts how many queens sit on each row, diagonal and
+// anti-diagonal; two queens in different columns attack along at most one
+// of those lines, so the number of attacking pairs is the sum of k(k-1)/2
+// over all lines holding k queens. Moving a queen, or asking what a move
+// would do, is O(1).
+class QueensConflicts
+{
+private:
+    int n;
+    std::vector<int> counts; // rows, then diagonals, then anti-diagonals
+    long long pairs;
+
+    int &rowCount(int row)
+    {
+        return counts[row];
+    }
+
+    int &diagonalCount(int col, int row)
+    {
+        return counts[n + row - col + n - 1];
+    }
+
+    int &antiDiagonalCount(int col, int row)
+    {
+        return counts[3 * n - 1 + row + col];
+    }
+
+public:
+    explicit QueensConflicts(int size = 0)
+    {
+        resize(size);
+    }
+
+    // Empties the board and makes it size x size
+    void resize(int size)
+    {
+        n = size;
+        counts.assign(size > 0 ? 5 * size - 2 : 0, 0);
+        pairs = 0;
+    }
+
+    // Empties the board and places a queen on rows[col] for every column
+    void reset(const int *rows)
+    {
+        std::fill(counts.begin(), counts.end(), 0);
+        pairs = 0;
+        for (int col = 0; col < n; col++)
+        {
+            place(col, rows[col]);
+        }
+    }
+
+    int size() const
+    {
+        return n;
+    }
+
+    // Queens on the row and diagonals through (col, row), a queen standing
+    // there counted once per line
+    int attacksOn(int col, int row) const
+    {
+        return counts[row] + counts[n + row - col + n - 1] + counts[3 * n - 1 + row + col];
+    }
+
+    void place(int col, int row)
+    {
+        pairs += attacksOn(col, row);
+        rowCount(row)++;
+        diagonalCount(col, row)++;
+        antiDiagonalCount(col, row)++;
+    }
+
+    void remove(int col, int row)
+    {
+        rowCount(row)--;
+        diagonalCount(col, row)--;
+        antiDiagonalCount(col, row)--;
+        pairs -= attacksOn(col, row);
+    }
+
+    // Change in attacking pairs if the queen of `col` moved from row `from`
+    // to row `to`. The two squares share a column, so no line through one
+    // passes through the other.
+    int moveDelta(int col, int from, int to) const
+    {
+        return from == to ? 0 : attacksOn(col, to) - (attacksOn(col, from) - 3);
+    }
+
+    void move(int col, int from, int to)
+    {
+        remove(col, from);
+        place(col, to);
+    }
+
+    long long conflicts() const
+    {
+        return pairs;
+    }
+};
+
+#endif
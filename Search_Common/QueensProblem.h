@@ -0,0 +1,222 @@
+#ifndef QUEENS_PROBLEM_H
+#define QUEENS_PROBLEM_H
+
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+#include "QueensConflicts.h"
+
+// Queen positions packed 4 bits per line (row or column, whichever the
+// program fills), storing position + 1 so that 0 means "no queen yet".
+// Boards up to PACKED_QUEENS_MAX x PACKED_QUEENS_MAX.
+const int PACKED_QUEENS_MAX = 15;
+
+struct PackedQueens
+{
+    uint64_t word;
+
+    PackedQueens() : word(0) {}
+    explicit PackedQueens(uint64_t w) : word(w) {}
+
+    // Position of the queen on `line`, -1 if none
+    int at(int line) const
+    {
+        return int((word >> (4 * line)) & 0xF) - 1;
+    }
+
+    PackedQueens placed(int line, int position) const
+    {
+        return PackedQueens((word & ~(uint64_t(0xF) << (4 * line))) | (uint64_t(position + 1) << (4 * line)));
+    }
+
+    bool operator==(const PackedQueens &other) const
+    {
+        return word == other.word;
+    }
+
+    // Number of attacking pairs among the queens that are on the board
+    int conflicts(int n) const
+    {
+        int count = 0;
+        for (int i = 0; i < n; i++)
+        {
+            int a = at(i);
+            if (a < 0)
+                continue;
+            for (int j = i + 1; j < n; j++)
+            {
+                int b = at(j);
+                if (b >= 0 && (a == b || abs(a - b) == j - i))
+                    count++;
+            }
+        }
+        return count;
+    }
+
+    std::vector<int> toVector(int n) const
+    {
+        std::vector<int> queens(n);
+        for (int line = 0; line < n; line++)
+        {
+            queens[line] = at(line);
+        }
+        return queens;
+    }
+};
+
+// Search<> policy that places queens line by line, only on squares no
+// earlier queen attacks. Every complete board is a solution, and the
+// heuristic is the number of queens still to place. Each board is reached
+// by exactly one sequence of placements, so no visited bitmap is needed.
+class QueensPlacementProblem
+{
+public:
+    typedef PackedQueens State;
+    static const bool HAS_DUPLICATES = false;
+
+protected:
+    int n;
+
+public:
+    explicit QueensPlacementProblem(int size) : n(size) {}
+
+    int size() const
+    {
+        return n;
+    }
+
+    // Lines are filled in order, so the count is the highest occupied line + 1
+    int placedCount(const State &queens) const
+    {
+        return queens.word == 0 ? 0 : (67 - __builtin_clzll(queens.word)) / 4;
+    }
+
+    uint64_t stateCount() const
+    {
+        uint64_t count = 1;
+        for (int i = 0; i < n; i++)
+        {
+            count *= n + 1;
+        }
+        return count;
+    }
+
+    uint64_t rank(const State &queens) const
+    {
+        uint64_t index = 0;
+        for (int line = n - 1; line >= 0; line--)
+        {
+            index = index * (n + 1) + (queens.at(line) + 1);
+        }
+        return index;
+    }
+
+    bool isGoal(const State &queens) const
+    {
+        return placedCount(queens) == n;
+    }
+
+    int heuristic(const State &queens) const
+    {
+        return n - placedCount(queens);
+    }
+
+    template <class Visit>
+    void forEachSuccessor(const State &queens, Visit &&visit) const
+    {
+        int line = placedCount(queens);
+        if (line == n)
+            return;
+        // Positions and both diagonals taken by the earlier queens, so each
+        // candidate is checked in O(1)
+        uint32_t positions = 0, diagonals = 0, antiDiagonals = 0;
+        for (int i = 0; i < line; i++)
+        {
+            int other = queens.at(i);
+            positions |= uint32_t(1) << other;
+            diagonals |= uint32_t(1) << (other - i + n - 1);
+            antiDiagonals |= uint32_t(1) << (other + i);
+        }
+        for (int position = 0; position < n; position++)
+        {
+            bool safe = !(positions >> position & 1) && !(diagonals >> (position - line + n - 1) & 1) &&
+                        !(antiDiagonals >> (position + line) & 1);
+            if (safe)
+                visit(queens.placed(line, position), position);
+        }
+    }
+};
+
+// Search<> policy over complete boards: a move shifts the queen on one line
+// to another position, the heuristic is the number of attacking pairs and
+// the goal is a board without any. Move numbers are line * n + position.
+// Ranked in base n, so n^n bits: keep n at 9 or below. Successors are
+// handed over with their heuristic, worked out from the parent's row and
+// diagonal counts in O(1) each, so an expansion costs O(n^2), not O(n^4).
+class QueensRepairProblem
+{
+public:
+    typedef PackedQueens State;
+    static const bool HAS_DUPLICATES = true;
+
+protected:
+    int n;
+
+public:
+    explicit QueensRepairProblem(int size) : n(size) {}
+
+    uint64_t stateCount() const
+    {
+        uint64_t count = 1;
+        for (int i = 0; i < n; i++)
+        {
+            count *= n;
+        }
+        return count;
+    }
+
+    uint64_t rank(const State &queens) const
+    {
+        uint64_t index = 0;
+        for (int line = n - 1; line >= 0; line--)
+        {
+            index = index * n + queens.at(line);
+        }
+        return index;
+    }
+
+    bool isGoal(const State &queens) const
+    {
+        return queens.conflicts(n) == 0;
+    }
+
+    int heuristic(const State &queens) const
+    {
+        return queens.conflicts(n);
+    }
+
+    template <class Visit>
+    void forEachSuccessor(const State &queens, Visit &&visit) const
+    {
+        int positions[16];
+        for (int line = 0; line < n; line++)
+        {
+            positions[line] = queens.at(line);
+        }
+        QueensConflicts tracker(n);
+        tracker.reset(positions);
+        int conflicts = int(tracker.conflicts());
+
+        for (int line = 0; line < n; line++)
+        {
+            for (int position = 0; position < n; position++)
+            {
+                if (positions[line] != position)
+                    visit(queens.placed(line, position), line * n + position,
+                          conflicts + tracker.moveDelta(line, positions[line], position));
+            }
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,70 @@
+#ifndef QUEENS_SYMMETRY_H
+#define QUEENS_SYMMETRY_H
+
+// Symmetries of an N-Queens solution under the dihedral group D4 (four
+// rotations, each with or without a reflection). queens[row] is the column
+// of the queen on that row. A solution is fundamental (canonical) when its
+// column list is the lexicographically smallest of its eight images.
+
+const int QUEENS_SYMMETRY_MAX = 32;
+
+// Writes image t (0..7) of `queens` into `out`
+inline void queensImage(const int *queens, int n, int t, int *out)
+{
+    for (int row = 0; row < n; row++)
+    {
+        int col = queens[row];
+        switch (t)
+        {
+        case 0: // identity
+            out[row] = col;
+            break;
+        case 1: // mirror left-right
+            out[row] = n - 1 - col;
+            break;
+        case 2: // mirror top-bottom
+            out[n - 1 - row] = col;
+            break;
+        case 3: // rotate 180
+            out[n - 1 - row] = n - 1 - col;
+            break;
+        case 4: // transpose
+            out[col] = row;
+            break;
+        case 5: // anti-transpose
+            out[n - 1 - col] = n - 1 - row;
+            break;
+        case 6: // rotate 90
+            out[col] = n - 1 - row;
+            break;
+        default: // rotate 270
+            out[n - 1 - col] = row;
+            break;
+        }
+    }
+}
+
+// Number of distinct images of the solution (8, 4 or 2), or 0 if some
+// image is lexicographically smaller, i.e. the solution is not canonical
+inline int queensMultiplicity(const int *queens, int n)
+{
+    int image[QUEENS_SYMMETRY_MAX];
+    int equal = 1; // images identical to the solution, the identity included
+    for (int t = 1; t < 8; t++)
+    {
+        queensImage(queens, n, t, image);
+        int order = 0;
+        for (int row = 0; row < n && order == 0; row++)
+        {
+            order = image[row] - queens[row];
+        }
+        if (order < 0)
+            return 0;
+        equal += order == 0;
+    }
+    // The images equal to the solution form its stabiliser; the orbit has
+    // 8 / |stabiliser| members
+    return 8 / equal;
+}
+
+#endif
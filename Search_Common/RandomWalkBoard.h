@@ -0,0 +1,54 @@
+#ifndef RANDOM_WALK_BOARD_H
+#define RANDOM_WALK_BOARD_H
+
+#include <random>
+#include <utility>
+#include <vector>
+#include "PackedPuzzle.h"
+
+// Scramble the default goal (1 2 ... with the blank last) with a random walk
+// of the blank that never undoes its last move. The same seed always gives
+// the same board, so walks make reproducible instances of a rough depth.
+template <int W>
+std::vector<int> randomWalkBoard(int steps, unsigned seed)
+{
+    const int cells = W * W;
+    std::vector<int> board(cells);
+    for (int cell = 0; cell < cells; cell++)
+    {
+        board[cell] = (cell + 1) % cells;
+    }
+
+    std::mt19937 gen(seed);
+    int blank = cells - 1;
+    int previousMove = -1;
+    for (int step = 0; step < steps;)
+    {
+        int move = gen() % 4;
+        int target = -1;
+        switch (move)
+        {
+        case MOVE_UP:
+            target = blank >= W ? blank - W : -1;
+            break;
+        case MOVE_DOWN:
+            target = blank < cells - W ? blank + W : -1;
+            break;
+        case MOVE_LEFT:
+            target = blank % W != 0 ? blank - 1 : -1;
+            break;
+        default:
+            target = blank % W != W - 1 ? blank + 1 : -1;
+            break;
+        }
+        if (target < 0 || move == (previousMove ^ 1))
+            continue;
+        std::swap(board[blank], board[target]);
+        blank = target;
+        previousMove = move;
+        step++;
+    }
+    return board;
+}
+
+#endif
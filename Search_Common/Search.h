@@ -0,0 +1,467 @@
+#ifndef SEARCH_H
+#define SEARCH_H
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+#include "StateBitmap.h"
+#include "BucketOpenList.h"
+#include "NodeArena.h"
+#include "SearchStats.h"
+
+// A problem plugs into Search<Problem> with these members, all resolved at
+// compile time so the successor loop inlines into each algorithm:
+//
+//   typedef ... State;                   small, trivially copyable, has ==
+//   static const bool HAS_DUPLICATES;    false if every state has one path
+//                                        (a tree), so no bitmap is kept
+//   uint64_t stateCount() const;         size of the rank space
+//   uint64_t rank(const State &) const;  perfect hash below stateCount()
+//   bool isGoal(const State &) const;
+//   int heuristic(const State &) const;  only used by greedy, A* and IDA*
+//   template <class Visit>
+//   void forEachSuccessor(const State &, Visit &&visit) const;
+//                                        calls visit(next, move), 0 <= move < 255,
+//                                        or visit(next, move, h) when the
+//                                        successor's heuristic is cheaper to
+//                                        work out from the parent
+//
+// Every move costs 1. The graph searches keep all nodes in a NodeArena and
+// detect duplicates with a StateBitmap over the ranks. Tree problems skip
+// the bitmap, which matters when a search is short and the rank space big.
+//
+// Built with -DSEARCH_INSTRUMENTATION, every search also counts duplicates
+// and open-list traffic, times its phases (see SearchStats.h) and writes a
+// one-line JSON summary to the report stream (std::clog unless changed).
+
+// Default callbacks: accept the first goal, do nothing when a node is expanded
+struct AcceptGoal
+{
+    bool operator()(uint32_t) const
+    {
+        return true;
+    }
+};
+
+struct IgnoreNode
+{
+    void operator()(uint32_t) const {}
+};
+
+// Open list of greedy best-first and A*
+enum BestFirstOrder
+{
+    // Buckets on f, ties on the lowest h; each state is expanded once
+    BEST_FIRST_BUCKETS,
+    // A binary heap on f alone, popped as std::priority_queue pops it, and
+    // no closed set, as a plain std::priority_queue loop expands them
+    BEST_FIRST_HEAP
+};
+
+template <class Problem>
+class Search
+{
+public:
+    typedef typename Problem::State State;
+    static const uint32_t NO_NODE = UINT32_MAX;
+
+private:
+    struct HeapEntry
+    {
+        int f;
+        uint32_t node;
+    };
+
+    // Lowest f on top
+    struct HeapAbove
+    {
+        bool operator()(const HeapEntry &a, const HeapEntry &b) const
+        {
+            return a.f > b.f;
+        }
+    };
+
+    const Problem &problem;
+    NodeArena<State> nodes;
+    StateBitmap visited;
+    BucketOpenList open;
+    std::vector<uint32_t> frontier; // queue or stack of node indices
+    std::vector<HeapEntry> heap;    // open list under BEST_FIRST_HEAP
+    BestFirstOrder order;
+    std::vector<State> idaPath;     // states on the current IDA* path
+    std::vector<int> idaMoves;
+    SearchStats counters;
+    std::ostream *report; // summary per search in instrumented builds
+    bool used;            // the bitmap and open list need clearing
+
+    // Marks the state and reports whether it was already marked
+    bool seen(const State &state)
+    {
+        if (!Problem::HAS_DUPLICATES)
+            return false;
+        SEARCH_PHASE(counters, PHASE_HASHING);
+        if (visited.testAndSet(problem.rank(state)))
+            return true;
+        SEARCH_COUNT(counters, closed);
+        return false;
+    }
+
+    bool wasSeen(const State &state)
+    {
+        if (!Problem::HAS_DUPLICATES)
+            return false;
+        SEARCH_PHASE(counters, PHASE_HASHING);
+        return visited.test(problem.rank(state));
+    }
+
+    int heuristic(const State &state)
+    {
+        SEARCH_PHASE(counters, PHASE_HEURISTIC);
+        return problem.heuristic(state);
+    }
+
+    // Stops the clock and reports; returns `result` for the caller to return
+    uint32_t finish(const char *algorithm, uint32_t result)
+    {
+        counters.stop();
+#ifdef SEARCH_INSTRUMENTATION
+        if (report != nullptr)
+        {
+            counters.writeJson(*report, algorithm);
+            *report << std::endl;
+        }
+#else
+        (void)algorithm;
+#endif
+        return result;
+    }
+
+    void start(const State &initial)
+    {
+        nodes.reset();
+        if (used)
+        {
+            visited.clear();
+            open.clear();
+        }
+        used = true;
+        frontier.clear();
+        heap.clear();
+        counters.reset();
+        counters.peakOpen = 1;
+        nodes.add(initial, 0);
+    }
+
+    // Best-first search ordered by f = weightG * g + h, ties on the lowest h.
+    // A state is closed when it is first taken off the open list.
+    template <class OnGoal, class OnExpand>
+    uint32_t bestFirst(const State &initial, int weightG, const char *algorithm, OnGoal &onGoal, OnExpand &onExpand)
+    {
+        if (order == BEST_FIRST_HEAP)
+            return heapFirst(initial, weightG, algorithm, onGoal, onExpand);
+        start(initial);
+        int h = heuristic(initial);
+        open.push(0, h, h);
+        SEARCH_COUNT(counters, pushes);
+
+        while (!open.empty())
+        {
+            uint32_t current;
+            {
+                SEARCH_PHASE(counters, PHASE_QUEUE);
+                current = open.pop();
+            }
+            SEARCH_COUNT(counters, pops);
+            State state = nodes.state(current);
+            if (seen(state))
+            {
+                SEARCH_COUNT(counters, stalePops);
+                continue;
+            }
+
+            counters.expanded++;
+            onExpand(current);
+            if (problem.isGoal(state) && onGoal(current))
+                return finish(algorithm, current);
+
+            int g = nodes.g(current) + 1;
+            SEARCH_PHASE(counters, PHASE_SUCCESSORS);
+            problem.forEachSuccessor(state, [&](const State &next, int move, int knownH = -1)
+                                     {
+                if (wasSeen(next))
+                {
+                    SEARCH_COUNT(counters, duplicates);
+                    return;
+                }
+                counters.generated++;
+                int nextH = knownH >= 0 ? knownH : heuristic(next);
+                SEARCH_PHASE(counters, PHASE_QUEUE);
+                SEARCH_COUNT(counters, pushes);
+                open.push(nodes.add(next, g, current, move), weightG * g + nextH, nextH); });
+            counters.peakOpen = std::max<uint64_t>(counters.peakOpen, open.size());
+        }
+        return finish(algorithm, NO_NODE);
+    }
+
+    // Best-first search under BEST_FIRST_HEAP. Nothing is closed, so a state
+    // reached along several paths is queued and expanded once per path.
+    template <class OnGoal, class OnExpand>
+    uint32_t heapFirst(const State &initial, int weightG, const char *algorithm, OnGoal &onGoal, OnExpand &onExpand)
+    {
+        start(initial);
+        heap.push_back({heuristic(initial), 0});
+        SEARCH_COUNT(counters, pushes);
+
+        while (!heap.empty())
+        {
+            uint32_t current;
+            {
+                SEARCH_PHASE(counters, PHASE_QUEUE);
+                std::pop_heap(heap.begin(), heap.end(), HeapAbove());
+                current = heap.back().node;
+                heap.pop_back();
+            }
+            SEARCH_COUNT(counters, pops);
+            State state = nodes.state(current);
+
+            counters.expanded++;
+            onExpand(current);
+            if (problem.isGoal(state) && onGoal(current))
+                return finish(algorithm, current);
+
+            int g = nodes.g(current) + 1;
+            SEARCH_PHASE(counters, PHASE_SUCCESSORS);
+            problem.forEachSuccessor(state, [&](const State &next, int move, int knownH = -1)
+                                     {
+                counters.generated++;
+                int nextH = knownH >= 0 ? knownH : heuristic(next);
+                SEARCH_PHASE(counters, PHASE_QUEUE);
+                SEARCH_COUNT(counters, pushes);
+                heap.push_back({weightG * g + nextH, nodes.add(next, g, current, move)});
+                std::push_heap(heap.begin(), heap.end(), HeapAbove()); });
+            counters.peakOpen = std::max<uint64_t>(counters.peakOpen, heap.size());
+        }
+        return finish(algorithm, NO_NODE);
+    }
+
+    // h < 0 when the problem did not hand over the heuristic of this state
+    int idaSearch(int g, int bound, int h = -1)
+    {
+        const int FOUND = -1;
+        const State state = idaPath.back();
+        if (h < 0)
+            h = heuristic(state);
+        if (g + h > bound)
+            return g + h;
+        if (problem.isGoal(state))
+            return FOUND;
+
+        counters.expanded++;
+        counters.peakOpen = std::max<uint64_t>(counters.peakOpen, idaPath.size());
+        int nextBound = INT_MAX;
+        SEARCH_PHASE(counters, PHASE_SUCCESSORS);
+        problem.forEachSuccessor(state, [&](const State &next, int move, int knownH = -1)
+                                 {
+            // Never step straight back to the parent
+            if (nextBound == FOUND || (idaPath.size() > 1 && next == idaPath[idaPath.size() - 2]))
+                return;
+            counters.generated++;
+            idaPath.push_back(next);
+            idaMoves.push_back(move);
+            SEARCH_PHASE(counters, PHASE_LOOP);
+            int t = idaSearch(g + 1, bound, knownH);
+            if (t == FOUND)
+            {
+                nextBound = FOUND;
+                return;
+            }
+            idaPath.pop_back();
+            idaMoves.pop_back();
+            nextBound = std::min(nextBound, t); });
+        return nextBound;
+    }
+
+public:
+    explicit Search(const Problem &p)
+        : problem(p), visited(Problem::HAS_DUPLICATES ? p.stateCount() : 0),
+          order(BEST_FIRST_BUCKETS), report(&std::clog), used(false) {}
+
+    // Open list of greedyBestFirst and aStar from the next search on
+    void setBestFirstOrder(BestFirstOrder o)
+    {
+        order = o;
+    }
+
+    // Each search returns the goal node it stopped at, or NO_NODE. onGoal is
+    // called for every goal reached and returns false to keep searching (to
+    // list all solutions); onExpand sees every node as it is expanded.
+
+    // States are marked when generated, so each is queued at most once
+    template <class OnGoal = AcceptGoal, class OnExpand = IgnoreNode>
+    uint32_t breadthFirst(const State &initial, OnGoal onGoal = OnGoal(), OnExpand onExpand = OnExpand())
+    {
+        start(initial);
+        seen(initial);
+        frontier.push_back(0);
+        SEARCH_COUNT(counters, pushes);
+
+        for (size_t head = 0; head < frontier.size(); head++)
+        {
+            uint32_t current = frontier[head];
+            SEARCH_COUNT(counters, pops);
+            State state = nodes.state(current);
+            counters.expanded++;
+            onExpand(current);
+            if (problem.isGoal(state) && onGoal(current))
+                return finish("breadth-first", current);
+
+            int g = nodes.g(current) + 1;
+            SEARCH_PHASE(counters, PHASE_SUCCESSORS);
+            problem.forEachSuccessor(state, [&](const State &next, int move, int = -1)
+                                     {
+                if (seen(next))
+                {
+                    SEARCH_COUNT(counters, duplicates);
+                    return;
+                }
+                counters.generated++;
+                SEARCH_PHASE(counters, PHASE_QUEUE);
+                SEARCH_COUNT(counters, pushes);
+                frontier.push_back(nodes.add(next, g, current, move)); });
+            counters.peakOpen = std::max<uint64_t>(counters.peakOpen, frontier.size() - head - 1);
+        }
+        return finish("breadth-first", NO_NODE);
+    }
+
+    // Successors are expanded in the order the problem generates them
+    template <class OnGoal = AcceptGoal, class OnExpand = IgnoreNode>
+    uint32_t depthFirst(const State &initial, OnGoal onGoal = OnGoal(), OnExpand onExpand = OnExpand())
+    {
+        start(initial);
+        seen(initial);
+        frontier.push_back(0);
+        SEARCH_COUNT(counters, pushes);
+
+        while (!frontier.empty())
+        {
+            uint32_t current = frontier.back();
+            frontier.pop_back();
+            SEARCH_COUNT(counters, pops);
+            State state = nodes.state(current);
+            counters.expanded++;
+            onExpand(current);
+            if (problem.isGoal(state) && onGoal(current))
+                return finish("depth-first", current);
+
+            int g = nodes.g(current) + 1;
+            size_t first = frontier.size();
+            {
+                SEARCH_PHASE(counters, PHASE_SUCCESSORS);
+                problem.forEachSuccessor(state, [&](const State &next, int move, int = -1)
+                                         {
+                    if (seen(next))
+                    {
+                        SEARCH_COUNT(counters, duplicates);
+                        return;
+                    }
+                    counters.generated++;
+                    SEARCH_PHASE(counters, PHASE_QUEUE);
+                    SEARCH_COUNT(counters, pushes);
+                    frontier.push_back(nodes.add(next, g, current, move)); });
+            }
+            SEARCH_PHASE(counters, PHASE_QUEUE);
+            std::reverse(frontier.begin() + first, frontier.end());
+            counters.peakOpen = std::max<uint64_t>(counters.peakOpen, frontier.size());
+        }
+        return finish("depth-first", NO_NODE);
+    }
+
+    // Ordered by h alone
+    template <class OnGoal = AcceptGoal, class OnExpand = IgnoreNode>
+    uint32_t greedyBestFirst(const State &initial, OnGoal onGoal = OnGoal(), OnExpand onExpand = OnExpand())
+    {
+        return bestFirst(initial, 0, "greedy-best-first", onGoal, onExpand);
+    }
+
+    // Ordered by g + h; optimal when the heuristic is consistent
+    template <class OnGoal = AcceptGoal, class OnExpand = IgnoreNode>
+    uint32_t aStar(const State &initial, OnGoal onGoal = OnGoal(), OnExpand onExpand = OnExpand())
+    {
+        return bestFirst(initial, 1, "a-star", onGoal, onExpand);
+    }
+
+    // Iterative-deepening A*: memory is the current path only; `moves`
+    // receives the solution. Returns false when no goal lies within a cost
+    // bound of maxBound. There is no duplicate detection, so on a problem
+    // with cycles (HAS_DUPLICATES) the bound keeps growing and, without a
+    // finite maxBound, an unreachable goal is never reported: check
+    // reachability first (PuzzleRanking::isSolvable for sliding puzzles) or
+    // pass a limit.
+    bool idaStar(const State &initial, std::vector<int> &moves, int maxBound = INT_MAX)
+    {
+        counters.reset();
+        idaPath.assign(1, initial);
+        idaMoves.clear();
+
+        int bound = heuristic(initial);
+        while (true)
+        {
+            int t = idaSearch(0, bound);
+            if (t == -1)
+                break;
+            if (t == INT_MAX || t > maxBound)
+            {
+                finish("ida-star", NO_NODE);
+                return false;
+            }
+            bound = t;
+        }
+        moves = idaMoves;
+        finish("ida-star", 0);
+        return true;
+    }
+
+    // Nodes of the last graph search, for paths and printing
+    const NodeArena<State> &arena() const
+    {
+        return nodes;
+    }
+
+    std::vector<int> movesTo(uint32_t node) const
+    {
+        return nodes.movesTo(node);
+    }
+
+    uint64_t nodesExpanded() const
+    {
+        return counters.expanded;
+    }
+
+    uint64_t nodesGenerated() const
+    {
+        return counters.generated;
+    }
+
+    // Largest open list (queue, stack or buckets) seen
+    size_t peakOpenSize() const
+    {
+        return counters.peakOpen;
+    }
+
+    // Counters of the last search; phase times only in instrumented builds
+    const SearchStats &stats() const
+    {
+        return counters;
+    }
+
+    // Where instrumented builds write the summary of each search; nullptr
+    // keeps it quiet (stats() still has it)
+    void reportTo(std::ostream *out)
+    {
+        report = out;
+    }
+};
+
+#endif
@@ -0,0 +1,167 @@
+#ifndef SEARCH_STATS_H
+#define SEARCH_STATS_H
+
+#include <algorithm>
+#include <cstdint>
+#include <ostream>
+
+// Counters and phase timers for Search<>. Expansions, generations and the
+// peak open size are always kept; everything else is only recorded when the
+// program is built with -DSEARCH_INSTRUMENTATION, and otherwise the macros
+// below compile to nothing.
+//
+// Phase times are exclusive: entering a phase stops the clock of the one it
+// interrupts, so heuristic calls made while generating successors are not
+// also charged to successor generation. Times are time-stamp counter cycles
+// on x86 and nanoseconds elsewhere.
+
+#ifdef SEARCH_INSTRUMENTATION
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+inline uint64_t searchClock()
+{
+    return __rdtsc();
+}
+#define SEARCH_CLOCK_UNIT "cycles"
+#else
+#include <chrono>
+inline uint64_t searchClock()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+#define SEARCH_CLOCK_UNIT "ns"
+#endif
+#endif
+
+enum SearchPhase
+{
+    PHASE_LOOP,       // the search loop itself and the callbacks
+    PHASE_SUCCESSORS, // forEachSuccessor, minus the work done per successor
+    PHASE_HEURISTIC,  // heuristic()
+    PHASE_HASHING,    // rank() and the visited bitmap
+    PHASE_QUEUE,      // open list, queue or stack, and storing nodes
+    PHASE_COUNT
+};
+
+const char *const SEARCH_PHASE_NAMES[PHASE_COUNT] = {"loop", "successors", "heuristic", "hashing", "queue"};
+
+struct SearchStats
+{
+    uint64_t expanded = 0;
+    uint64_t generated = 0;
+    uint64_t duplicates = 0; // successors dropped because the state was seen
+    uint64_t pushes = 0;
+    uint64_t pops = 0;
+    uint64_t stalePops = 0; // popped for a state closed since it was queued
+    uint64_t closed = 0;    // states marked in the visited bitmap
+    uint64_t peakOpen = 0;  // largest queue, stack, open list or IDA* path
+    uint64_t phaseTime[PHASE_COUNT] = {};
+
+#ifdef SEARCH_INSTRUMENTATION
+    int phase = PHASE_LOOP;
+    uint64_t phaseStart = 0;
+
+    // Switches the clock to `next` and returns the phase it interrupted
+    int enterPhase(int next)
+    {
+        uint64_t now = searchClock();
+        phaseTime[phase] += now - phaseStart;
+        phaseStart = now;
+        int previous = phase;
+        phase = next;
+        return previous;
+    }
+
+    void leavePhase(int previous)
+    {
+        enterPhase(previous);
+    }
+#endif
+
+    // Clears everything and starts the clock in PHASE_LOOP
+    void reset()
+    {
+        *this = SearchStats();
+#ifdef SEARCH_INSTRUMENTATION
+        phaseStart = searchClock();
+#endif
+    }
+
+    // Charges the time since the last phase change; call when a search ends
+    void stop()
+    {
+#ifdef SEARCH_INSTRUMENTATION
+        enterPhase(phase);
+#endif
+    }
+
+    // Totals over several searches; peaks take the maximum
+    SearchStats &operator+=(const SearchStats &other)
+    {
+        expanded += other.expanded;
+        generated += other.generated;
+        duplicates += other.duplicates;
+        pushes += other.pushes;
+        pops += other.pops;
+        stalePops += other.stalePops;
+        closed = std::max(closed, other.closed);
+        peakOpen = std::max(peakOpen, other.peakOpen);
+        for (int p = 0; p < PHASE_COUNT; p++)
+        {
+            phaseTime[p] += other.phaseTime[p];
+        }
+        return *this;
+    }
+
+    // One JSON object; the phase times only exist in instrumented builds
+    void writeJson(std::ostream &out, const char *algorithm) const
+    {
+        out << "{\"search\": \"" << algorithm << "\", \"expanded\": " << expanded
+            << ", \"generated\": " << generated << ", \"duplicates\": " << duplicates
+            << ", \"pushes\": " << pushes << ", \"pops\": " << pops
+            << ", \"stale_pops\": " << stalePops << ", \"peak_open\": " << peakOpen
+            << ", \"peak_closed\": " << closed;
+#ifdef SEARCH_INSTRUMENTATION
+        out << ", \"phase_" << SEARCH_CLOCK_UNIT << "\": {";
+        for (int p = 0; p < PHASE_COUNT; p++)
+        {
+            out << (p > 0 ? ", " : "") << "\"" << SEARCH_PHASE_NAMES[p] << "\": " << phaseTime[p];
+        }
+        out << "}";
+#endif
+        out << "}";
+    }
+};
+
+#ifdef SEARCH_INSTRUMENTATION
+// Charges the rest of the enclosing scope to a phase, then resumes the
+// interrupted one. Scopes nest to any depth, including IDA*'s recursion.
+struct SearchPhaseScope
+{
+    SearchStats &stats;
+    int previous;
+
+    SearchPhaseScope(SearchStats &s, int phase) : stats(s), previous(s.enterPhase(phase)) {}
+
+    ~SearchPhaseScope()
+    {
+        stats.leavePhase(previous);
+    }
+};
+
+#define SEARCH_CONCAT_(a, b) a##b
+#define SEARCH_CONCAT(a, b) SEARCH_CONCAT_(a, b)
+#define SEARCH_COUNT(stats, field) ((stats).field++)
+#define SEARCH_PHASE(stats, phase) SearchPhaseScope SEARCH_CONCAT(searchPhase, __LINE__)(stats, phase)
+#else
+#define SEARCH_COUNT(stats, field) ((void)0)
+#define SEARCH_PHASE(stats, phase) ((void)0)
+#endif
+
+#endif
@@ -0,0 +1,257 @@
+#ifndef SEARCH_TRACE_H
+#define SEARCH_TRACE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+#include <vector>
+#include "NodeArena.h"
+
+// Binary search traces: one fixed-size record per expanded node, pushed into
+// a single-producer single-consumer ring and written to a file by a
+// background thread, so the search never waits on I/O. SearchTraceDecoder
+// (Tools/) turns a trace back into readable boards and paths.
+
+// What the packed state in a record is, so the decoder can print it
+enum TraceStateKind
+{
+    TRACE_STATE_RAW = 0,         // printed as hex
+    TRACE_STATE_PUZZLE = 1,      // PackedPuzzle<width>
+    TRACE_STATE_TIC_TAC_TOE = 2, // TicTacToeBoard
+    TRACE_STATE_QUEENS = 3       // PackedQueens on a width x width board
+};
+
+const char TRACE_MAGIC[4] = {'S', 'T', 'R', 'C'};
+const uint16_t TRACE_VERSION = 3; // 2: tic-tac-toe states as two bitboards, 3: 32-bit g
+
+struct TraceHeader
+{
+    char magic[4];
+    uint16_t version;
+    uint16_t recordSize;
+    uint16_t stateKind;
+    uint16_t width;
+    uint32_t reserved;
+};
+
+// Parent is the node id of the parent (UINT32_MAX for the root), so paths
+// can be rebuilt from the records alone
+struct TraceRecord
+{
+    uint64_t state; // the packed state's word
+    uint32_t node;
+    uint32_t parent;
+    uint32_t g;
+    uint16_t h;
+    uint8_t move;
+    uint8_t padding;
+};
+
+static_assert(sizeof(TraceHeader) == 16, "trace header layout");
+static_assert(sizeof(TraceRecord) == 24, "trace record layout");
+
+// Lock-free ring for one producer and one consumer. Capacity is a power of
+// two; head and tail only ever grow and are masked on access.
+template <class T>
+class SpscRing
+{
+private:
+    std::vector<T> slots;
+    size_t mask;
+    alignas(64) std::atomic<size_t> head; // next slot to read, owned by the consumer
+    alignas(64) std::atomic<size_t> tail; // next slot to write, owned by the producer
+    size_t cachedHead;                    // producer's last view of head
+
+public:
+    explicit SpscRing(size_t capacity) : slots(capacity), mask(capacity - 1), head(0), tail(0), cachedHead(0) {}
+
+    bool tryPush(const T &value)
+    {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (t - cachedHead == slots.size())
+        {
+            cachedHead = head.load(std::memory_order_acquire);
+            if (t - cachedHead == slots.size())
+                return false;
+        }
+        slots[t & mask] = value;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Moves up to `count` values into `out`; returns how many
+    size_t popInto(T *out, size_t count)
+    {
+        size_t h = head.load(std::memory_order_relaxed);
+        size_t available = tail.load(std::memory_order_acquire) - h;
+        if (available < count)
+            count = available;
+        for (size_t i = 0; i < count; i++)
+        {
+            out[i] = slots[(h + i) & mask];
+        }
+        head.store(h + count, std::memory_order_release);
+        return count;
+    }
+};
+
+class TraceWriter
+{
+private:
+    static const size_t RING_RECORDS = 1 << 16;
+    static const size_t BATCH_RECORDS = 4096;
+
+    SpscRing<TraceRecord> ring;
+    FILE *file;
+    std::thread drainer;
+    std::atomic<bool> stopping;
+    std::atomic<bool> failed; // a write came up short; the file is incomplete
+    uint64_t records;
+    uint64_t stalls;
+
+    // Background thread: write whatever is queued, nap when idle, and
+    // after close() empty the ring before returning. After a failed write
+    // it keeps emptying the ring, so record() never blocks, but writes
+    // nothing more.
+    void drain()
+    {
+        std::vector<TraceRecord> batch(BATCH_RECORDS);
+        while (true)
+        {
+            bool last = stopping.load(std::memory_order_acquire);
+            size_t count = ring.popInto(batch.data(), batch.size());
+            if (count > 0)
+            {
+                if (!failed.load(std::memory_order_relaxed) &&
+                    fwrite(batch.data(), sizeof(TraceRecord), count, file) != count)
+                    failed.store(true, std::memory_order_relaxed);
+            }
+            else if (last)
+                break;
+            else
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    }
+
+public:
+    TraceWriter() : ring(RING_RECORDS), file(nullptr), stopping(false), failed(false), records(0), stalls(0) {}
+
+    ~TraceWriter()
+    {
+        close();
+    }
+
+    TraceWriter(const TraceWriter &) = delete;
+    TraceWriter &operator=(const TraceWriter &) = delete;
+
+    bool open(const char *path, TraceStateKind kind, int width = 0)
+    {
+        close();
+        file = fopen(path, "wb");
+        if (file == nullptr)
+            return false;
+
+        TraceHeader header = {};
+        for (int i = 0; i < 4; i++)
+        {
+            header.magic[i] = TRACE_MAGIC[i];
+        }
+        header.version = TRACE_VERSION;
+        header.recordSize = sizeof(TraceRecord);
+        header.stateKind = uint16_t(kind);
+        header.width = uint16_t(width);
+        if (fwrite(&header, sizeof(header), 1, file) != 1)
+        {
+            fclose(file);
+            file = nullptr;
+            return false;
+        }
+
+        stopping.store(false);
+        failed.store(false);
+        records = 0;
+        stalls = 0;
+        drainer = std::thread(&TraceWriter::drain, this);
+        return true;
+    }
+
+    bool isOpen() const
+    {
+        return file != nullptr;
+    }
+
+    // Never drops a record: if the writer falls behind, the search waits
+    void record(const TraceRecord &entry)
+    {
+        while (!ring.tryPush(entry))
+        {
+            stalls++;
+            std::this_thread::yield();
+        }
+        records++;
+    }
+
+    // Flushes everything queued and closes the file. Returns false if any
+    // write failed (a full disk, say): the trace on disk is then cut short.
+    bool close()
+    {
+        if (file == nullptr)
+            return !failed.load();
+        stopping.store(true, std::memory_order_release);
+        drainer.join();
+        if (fflush(file) != 0)
+            failed.store(true);
+        if (fclose(file) != 0)
+            failed.store(true);
+        file = nullptr;
+        return !failed.load();
+    }
+
+    // Whether a write of the last trace failed; final once close() returned
+    bool hasFailed() const
+    {
+        return failed.load();
+    }
+
+    uint64_t recordCount() const
+    {
+        return records;
+    }
+
+    // Times record() found the ring full
+    uint64_t stallCount() const
+    {
+        return stalls;
+    }
+};
+
+// onExpand callback for Search<> that traces every expanded node
+template <class Problem>
+struct TraceExpansions
+{
+    const Problem &problem;
+    const NodeArena<typename Problem::State> &nodes;
+    TraceWriter &writer;
+
+    void operator()(uint32_t node) const
+    {
+        TraceRecord entry = {};
+        entry.state = nodes.state(node).word;
+        entry.node = node;
+        entry.parent = nodes.parent(node);
+        entry.g = uint32_t(nodes.g(node));
+        entry.h = uint16_t(problem.heuristic(nodes.state(node)));
+        entry.move = nodes.move(node);
+        writer.record(entry);
+    }
+};
+
+template <class Problem>
+TraceExpansions<Problem> traceExpansions(const Problem &problem, const NodeArena<typename Problem::State> &nodes, TraceWriter &writer)
+{
+    return TraceExpansions<Problem>{problem, nodes, writer};
+}
+
+#endif
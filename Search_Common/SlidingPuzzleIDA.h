@@ -0,0 +1,250 @@
+#ifndef SLIDING_PUZZLE_IDA_H
+#define SLIDING_PUZZLE_IDA_H
+
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+#include "PackedPuzzle.h"
+#include "PatternDatabase.h"
+
+// Iterative-deepening A* for W x W sliding puzzles (4x4, 5x5, ...).
+// The board is modified in place with make/unmake moves, the move that
+// would undo the parent's move is never generated, and the Manhattan
+// distance is updated by the one tile that moves. Memory is the board plus
+// the current path, so it is linear in the solution depth.
+// With a pattern database attached, the heuristic is the sum of its tables
+// instead, and a move only re-ranks the pattern containing the moved tile.
+template <int W>
+class SlidingPuzzleIDA
+{
+public:
+    static const int CELLS = W * W;
+
+private:
+    static const int FOUND = -1;
+
+    int tiles[CELLS];              // tiles[cell], 0 is the blank
+    int cellOf[CELLS];             // cellOf[tile], inverse of tiles
+    int blank;                     // cell of the blank
+    int h;                         // heuristic value of the current board
+    const PatternDatabase *pdb;    // additive tables, or nullptr for Manhattan
+    int patternH[PDB_MAX_PATTERNS]; // current value of each pattern's table
+    int goalTiles[CELLS];          // goal layout
+    int distance[CELLS][CELLS];    // distance[tile][cell] to the tile's goal cell
+    int neighbours[CELLS][4];      // cell the blank moves into, -1 if off the board
+    std::vector<int> path;         // moves from the start to the current board
+    uint64_t expanded;
+    uint64_t generated;
+
+    int search(int g, int bound, int previousMove)
+    {
+        int f = g + h;
+        if (f > bound)
+            return f;
+        if (h == 0 && isGoal())
+            return FOUND;
+
+        expanded++;
+        int nextBound = INT_MAX;
+        for (int move = 0; move < 4; move++)
+        {
+            // Never undo the move that led here (UP/DOWN and LEFT/RIGHT pair up)
+            if (move == (previousMove ^ 1))
+                continue;
+            int target = neighbours[blank][move];
+            if (target < 0)
+                continue;
+
+            // Make: slide the tile into the blank
+            int tile = tiles[target];
+            int oldBlank = blank;
+            tiles[oldBlank] = tile;
+            tiles[target] = 0;
+            cellOf[tile] = oldBlank;
+            cellOf[0] = target;
+            blank = target;
+
+            int deltaH;
+            int pattern = pdb != nullptr ? pdb->patternOf(tile) : -1;
+            int oldPatternH = 0;
+            if (pattern >= 0)
+            {
+                oldPatternH = patternH[pattern];
+                patternH[pattern] = pdb->lookup(pattern, cellOf);
+                deltaH = patternH[pattern] - oldPatternH;
+            }
+            else
+            {
+                deltaH = distance[tile][oldBlank] - distance[tile][target];
+            }
+            h += deltaH;
+            path.push_back(move);
+            generated++;
+
+            int t = search(g + 1, bound, move);
+            if (t == FOUND)
+                return FOUND;
+
+            // Unmake
+            path.pop_back();
+            h -= deltaH;
+            if (pattern >= 0)
+                patternH[pattern] = oldPatternH;
+            blank = oldBlank;
+            tiles[target] = tile;
+            tiles[oldBlank] = 0;
+            cellOf[tile] = target;
+            cellOf[0] = oldBlank;
+
+            if (t < nextBound)
+                nextBound = t;
+        }
+        return nextBound;
+    }
+
+    bool isGoal() const
+    {
+        for (int cell = 0; cell < CELLS; cell++)
+        {
+            if (tiles[cell] != goalTiles[cell])
+                return false;
+        }
+        return true;
+    }
+
+public:
+    // goal lists the tile in each cell; defaults to 1 2 ... with the blank last
+    explicit SlidingPuzzleIDA(const int *goal = nullptr) : blank(0), h(0), pdb(nullptr), expanded(0), generated(0)
+    {
+        for (int cell = 0; cell < CELLS; cell++)
+        {
+            goalTiles[cell] = goal != nullptr ? goal[cell] : (cell + 1) % CELLS;
+        }
+
+        for (int cell = 0; cell < CELLS; cell++)
+        {
+            int tile = goalTiles[cell];
+            for (int from = 0; from < CELLS; from++)
+            {
+                distance[tile][from] = tile == 0 ? 0 : abs(from / W - cell / W) + abs(from % W - cell % W);
+            }
+        }
+
+        for (int cell = 0; cell < CELLS; cell++)
+        {
+            neighbours[cell][MOVE_UP] = cell >= W ? cell - W : -1;
+            neighbours[cell][MOVE_DOWN] = cell < CELLS - W ? cell + W : -1;
+            neighbours[cell][MOVE_LEFT] = cell % W != 0 ? cell - 1 : -1;
+            neighbours[cell][MOVE_RIGHT] = cell % W != W - 1 ? cell + 1 : -1;
+        }
+    }
+
+    // Use an additive pattern database instead of Manhattan distance. It must
+    // have been built for this board size and goal; returns false otherwise.
+    bool usePatternDatabase(const PatternDatabase *database)
+    {
+        if (database == nullptr || database->width() != W)
+            return false;
+        for (int cell = 0; cell < CELLS; cell++)
+        {
+            if (database->goalCell(goalTiles[cell]) != cell)
+                return false;
+        }
+        pdb = database;
+        return true;
+    }
+
+    // Full Manhattan distance; during the search it is only updated incrementally
+    int calculateManhattanDistance(const int *board) const
+    {
+        int total = 0;
+        for (int cell = 0; cell < CELLS; cell++)
+        {
+            total += distance[board[cell]][cell];
+        }
+        return total;
+    }
+
+    // Solves `start` optimally. Returns false only if the board is unsolvable.
+    bool solve(const int *start, std::vector<int> &solution)
+    {
+        for (int cell = 0; cell < CELLS; cell++)
+        {
+            tiles[cell] = start[cell];
+            cellOf[tiles[cell]] = cell;
+            if (tiles[cell] == 0)
+                blank = cell;
+        }
+        if (!isSolvable())
+            return false;
+
+        if (pdb != nullptr)
+        {
+            h = 0;
+            for (int p = 0; p < pdb->patternCount(); p++)
+            {
+                patternH[p] = pdb->lookup(p, cellOf);
+                h += patternH[p];
+            }
+        }
+        else
+        {
+            h = calculateManhattanDistance(tiles);
+        }
+        expanded = 0;
+        generated = 0;
+        path.clear();
+
+        int bound = h;
+        while (true)
+        {
+            int t = search(0, bound, -1);
+            if (t == FOUND)
+                break;
+            bound = t;
+        }
+        solution = path;
+        return true;
+    }
+
+    // Same parity class as the goal: tile inversions plus the blank's row,
+    // where the row only matters for even widths
+    bool isSolvable() const
+    {
+        int parity = 0;
+        for (int side = 0; side < 2; side++)
+        {
+            const int *board = side == 0 ? tiles : goalTiles;
+            int inversions = 0;
+            int blankRow = 0;
+            for (int i = 0; i < CELLS; i++)
+            {
+                if (board[i] == 0)
+                {
+                    blankRow = i / W;
+                    continue;
+                }
+                for (int j = i + 1; j < CELLS; j++)
+                {
+                    if (board[j] != 0 && board[j] < board[i])
+                        inversions++;
+                }
+            }
+            parity ^= (inversions + (W % 2 == 0 ? blankRow : 0)) & 1;
+        }
+        return parity == 0;
+    }
+
+    uint64_t nodesExpanded() const
+    {
+        return expanded;
+    }
+
+    uint64_t nodesGenerated() const
+    {
+        return generated;
+    }
+};
+
+#endif
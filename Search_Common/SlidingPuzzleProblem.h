@@ -0,0 +1,64 @@
+#ifndef SLIDING_PUZZLE_PROBLEM_H
+#define SLIDING_PUZZLE_PROBLEM_H
+
+#include <cstdint>
+#include "PackedPuzzle.h"
+#include "PermutationRank.h"
+
+// Search<> policy for the W x W sliding puzzle on packed boards. Moves are
+// tried in the given order (default UP, DOWN, LEFT, RIGHT), and states are
+// ranked over the solvable half of the permutations. The goal is 1 2 ...
+// with the blank last; the heuristic is Manhattan distance.
+template <int W>
+class SlidingPuzzleProblem
+{
+public:
+    typedef PackedPuzzle<W> State;
+    static const bool HAS_DUPLICATES = true;
+
+private:
+    int moveOrder[4];
+
+public:
+    explicit SlidingPuzzleProblem(const int *order = nullptr)
+    {
+        for (int i = 0; i < 4; i++)
+        {
+            moveOrder[i] = order != nullptr ? order[i] : i;
+        }
+    }
+
+    uint64_t stateCount() const
+    {
+        return PuzzleRanking<W>::size();
+    }
+
+    uint64_t rank(const State &board) const
+    {
+        return PuzzleRanking<W>::rank(board);
+    }
+
+    bool isGoal(const State &board) const
+    {
+        return board.isGoal();
+    }
+
+    int heuristic(const State &board) const
+    {
+        return board.manhattanDistance();
+    }
+
+    template <class Visit>
+    void forEachSuccessor(const State &board, Visit &&visit) const
+    {
+        int blank = board.blank();
+        for (int i = 0; i < 4; i++)
+        {
+            int target = State::targetCell(blank, moveOrder[i]);
+            if (target >= 0)
+                visit(board.movedTo(target), moveOrder[i]);
+        }
+    }
+};
+
+#endif
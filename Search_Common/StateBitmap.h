@@ -0,0 +1,102 @@
+#ifndef STATE_BITMAP_H
+#define STATE_BITMAP_H
+
+#include <cstdint>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+// One bit per state, indexed by a perfect-hash rank. Sized once up front,
+// so membership tests and inserts never allocate.
+class StateBitmap
+{
+private:
+    std::vector<uint64_t> words;
+
+public:
+    explicit StateBitmap(uint64_t states) : words((states + 63) / 64, 0) {}
+
+    bool test(uint64_t index) const
+    {
+        return (words[index >> 6] >> (index & 63)) & 1;
+    }
+
+    // Marks the state and reports whether it was already marked
+    bool testAndSet(uint64_t index)
+    {
+        uint64_t bit = uint64_t(1) << (index & 63);
+        uint64_t &word = words[index >> 6];
+        bool wasSet = (word & bit) != 0;
+        word |= bit;
+        return wasSet;
+    }
+
+    // Calls visit(index) for every marked state in increasing order
+    template <class Visitor>
+    void forEachSet(Visitor visit) const
+    {
+        for (size_t w = 0; w < words.size(); w++)
+        {
+            uint64_t bits = words[w];
+            while (bits != 0)
+            {
+                visit(uint64_t(w) * 64 + __builtin_ctzll(bits));
+                bits &= bits - 1;
+            }
+        }
+    }
+
+    void clear()
+    {
+        std::fill(words.begin(), words.end(), 0);
+    }
+
+    size_t bytes() const
+    {
+        return words.size() * sizeof(uint64_t);
+    }
+};
+
+// StateBitmap that several threads can mark at once. Marking is a relaxed
+// fetch-or, preceded by a plain load so states that are already marked
+// never take the cache line exclusive.
+class AtomicStateBitmap
+{
+private:
+    std::unique_ptr<std::atomic<uint64_t>[]> words;
+    size_t wordCount;
+
+public:
+    explicit AtomicStateBitmap(uint64_t states)
+        : words(new std::atomic<uint64_t>[(states + 63) / 64]), wordCount((states + 63) / 64)
+    {
+        for (size_t w = 0; w < wordCount; w++)
+        {
+            words[w].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    bool test(uint64_t index) const
+    {
+        return (words[index >> 6].load(std::memory_order_relaxed) >> (index & 63)) & 1;
+    }
+
+    // Marks the state and reports whether it was already marked. Exactly one
+    // of several threads racing on the same state sees false.
+    bool testAndSet(uint64_t index)
+    {
+        uint64_t bit = uint64_t(1) << (index & 63);
+        std::atomic<uint64_t> &word = words[index >> 6];
+        if (word.load(std::memory_order_relaxed) & bit)
+            return true;
+        return (word.fetch_or(bit, std::memory_order_relaxed) & bit) != 0;
+    }
+
+    size_t bytes() const
+    {
+        return wordCount * sizeof(uint64_t);
+    }
+};
+
+#endif
@@ -0,0 +1,103 @@
+#ifndef TIC_TAC_TOE_PERFECT_PLAY_H
+#define TIC_TAC_TOE_PERFECT_PLAY_H
+
+#include <cstdint>
+#include "TicTacToeProblem.h"
+
+// Game value and best move of every tic-tac-toe position, solved by the
+// compiler: the table is a constexpr object, so looking a position up costs
+// one load and nothing runs at startup.
+//
+// Entries are indexed by TicTacToeBoard::index(). A move adds a digit, so
+// every successor has a higher index than its parent, and one pass from
+// the top index down sees each position after all of its successors: a
+// plain retrograde negamax, no recursion. Values are for the player to
+// move: the previous player having completed a line is a loss, a full
+// board a draw. The best move is the lowest cell reaching the value.
+
+const int TTT_LOSS = -1;
+const int TTT_DRAW = 0;
+const int TTT_WIN = 1;
+const int TTT_NO_MOVE = 15;
+const int TTT_POSITIONS = 19683;      // 3^9, legal or not
+const int TTT_LEGAL_POSITIONS = 5478; // reachable from the empty board
+
+struct TicTacToePerfectTable
+{
+    // Bits 0-3 best move (TTT_NO_MOVE when the game is over), bits 4-5
+    // value + 1, bit 7 set for legal positions
+    uint8_t entries[TTT_POSITIONS];
+    int legalCount;
+
+    static constexpr uint8_t LEGAL = 0x80;
+
+    constexpr TicTacToePerfectTable() : entries(), legalCount(0)
+    {
+        for (int index = TTT_POSITIONS - 1; index >= 0; index--)
+        {
+            // Digits of the index: 1 for X, 2 for O
+            uint32_t xs = 0, os = 0;
+            int digits = index;
+            for (int cell = 0; cell < 9; cell++, digits /= 3)
+            {
+                xs |= uint32_t(digits % 3 == TTT_X) << cell;
+                os |= uint32_t(digits % 3 == TTT_O) << cell;
+            }
+
+            // Legal: X moved first, at most one side has a line, and the
+            // side with a line made the last move
+            int xCount = __builtin_popcount(xs), oCount = __builtin_popcount(os);
+            bool xWon = TTT_TABLES.wins[xs], oWon = TTT_TABLES.wins[os];
+            if (xCount != oCount && xCount != oCount + 1)
+                continue;
+            if ((xWon && xCount != oCount + 1) || (oWon && xCount != oCount))
+                continue;
+            legalCount++;
+
+            int value = TTT_LOSS, move = TTT_NO_MOVE;
+            if (!xWon && !oWon && xCount + oCount == 9)
+                value = TTT_DRAW;
+            else if (!xWon && !oWon)
+            {
+                int digit = xCount == oCount ? TTT_X : TTT_O;
+                value = TTT_LOSS - 1;
+                uint32_t power = 1;
+                for (int cell = 0; cell < 9; cell++, power *= 3)
+                {
+                    if (((xs | os) >> cell & 1) == 0)
+                    {
+                        int child = -((entries[index + digit * power] >> 4 & 3) - 1);
+                        if (child > value)
+                        {
+                            value = child;
+                            move = cell;
+                        }
+                    }
+                }
+            }
+            entries[index] = uint8_t(LEGAL | (value + 1) << 4 | move);
+        }
+    }
+};
+
+constexpr TicTacToePerfectTable TTT_PERFECT;
+static_assert(TTT_PERFECT.legalCount == TTT_LEGAL_POSITIONS, "tic-tac-toe has 5,478 legal positions");
+
+inline bool isLegalPosition(const TicTacToeBoard &board)
+{
+    return (TTT_PERFECT.entries[board.index()] & TicTacToePerfectTable::LEGAL) != 0;
+}
+
+// TTT_WIN, TTT_DRAW or TTT_LOSS for the player to move, with perfect play
+inline int perfectValue(const TicTacToeBoard &board)
+{
+    return (TTT_PERFECT.entries[board.index()] >> 4 & 3) - 1;
+}
+
+// Cell the player to move should take, or TTT_NO_MOVE if the game is over
+inline int perfectMove(const TicTacToeBoard &board)
+{
+    return TTT_PERFECT.entries[board.index()] & 0xF;
+}
+
+#endif
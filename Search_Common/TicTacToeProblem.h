@@ -0,0 +1,154 @@
+#ifndef TIC_TAC_TOE_PROBLEM_H
+#define TIC_TAC_TOE_PROBLEM_H
+
+#include <cstdint>
+
+const int TTT_EMPTY = 0;
+const int TTT_X = 1;
+const int TTT_O = 2;
+
+const uint32_t TTT_ALL_CELLS = 0x1FF;
+
+// The eight winning lines as 9-bit cell masks (bit c = cell c)
+const uint32_t TTT_LINE_MASKS[8] = {
+    0x007, 0x038, 0x1C0, // rows
+    0x049, 0x092, 0x124, // columns
+    0x111, 0x054};       // diagonals
+
+// Tables over every 9-bit set of cells, filled at compile time: whether
+// the set holds a whole line, and the set's base-3 value with each cell
+// as a digit 1 (so X's cells give 1s and O's, doubled, 2s).
+struct TicTacToeTables
+{
+    bool wins[512];
+    uint16_t base3[512];
+
+    constexpr TicTacToeTables() : wins(), base3()
+    {
+        for (uint32_t cells = 0; cells < 512; cells++)
+        {
+            for (uint32_t line : TTT_LINE_MASKS)
+            {
+                wins[cells] = wins[cells] || (cells & line) == line;
+            }
+            uint32_t power = 1;
+            for (int cell = 0; cell < 9; cell++)
+            {
+                if (cells >> cell & 1)
+                    base3[cells] += power;
+                power *= 3;
+            }
+        }
+    }
+};
+
+constexpr TicTacToeTables TTT_TABLES;
+
+// Tic-tac-toe board as two bitboards in one word: X's cells in bits 0-8,
+// O's in bits 9-17, cells in reading order. X moves first, so whose turn it
+// is follows from the number of marks.
+struct TicTacToeBoard
+{
+    uint32_t word;
+
+    TicTacToeBoard() : word(0) {}
+    explicit TicTacToeBoard(uint32_t w) : word(w) {}
+
+    // Cells holding `mark` (TTT_X or TTT_O)
+    uint32_t cells(int mark) const
+    {
+        return mark == TTT_X ? word & TTT_ALL_CELLS : word >> 9;
+    }
+
+    uint32_t emptyCells() const
+    {
+        return ~(word | word >> 9) & TTT_ALL_CELLS;
+    }
+
+    int at(int cell) const
+    {
+        return (word >> cell & 1) ? TTT_X : (word >> (9 + cell) & 1) ? TTT_O : TTT_EMPTY;
+    }
+
+    TicTacToeBoard marked(int cell, int mark) const
+    {
+        return TicTacToeBoard(word | uint32_t(1) << (mark == TTT_X ? cell : 9 + cell));
+    }
+
+    bool operator==(const TicTacToeBoard &other) const
+    {
+        return word == other.word;
+    }
+
+    int markCount() const
+    {
+        return __builtin_popcount(word);
+    }
+
+    int playerToMove() const
+    {
+        return markCount() % 2 == 0 ? TTT_X : TTT_O;
+    }
+
+    bool hasWon(int mark) const
+    {
+        return TTT_TABLES.wins[cells(mark)];
+    }
+
+    bool isGameOver() const
+    {
+        return hasWon(TTT_X) || hasWon(TTT_O) || markCount() == 9;
+    }
+
+    // Base-3 index below 3^9, cell c being digit c (TTT_EMPTY, TTT_X or
+    // TTT_O), for tables over all positions
+    uint32_t index() const
+    {
+        return TTT_TABLES.base3[cells(TTT_X)] + 2u * TTT_TABLES.base3[cells(TTT_O)];
+    }
+};
+
+// Search<> policy where a move puts the mark of the player to move on an
+// empty cell (move number = cell). The goal is a position someone has won.
+// The heuristic is 0; programs derive their own policy to rank positions.
+class TicTacToeProblem
+{
+public:
+    typedef TicTacToeBoard State;
+    static const bool HAS_DUPLICATES = true;
+
+    uint64_t stateCount() const
+    {
+        return 19683; // 3^9
+    }
+
+    uint64_t rank(const State &board) const
+    {
+        return board.index();
+    }
+
+    bool isGoal(const State &board) const
+    {
+        return board.hasWon(TTT_X) || board.hasWon(TTT_O);
+    }
+
+    int heuristic(const State &) const
+    {
+        return 0;
+    }
+
+    template <class Visit>
+    void forEachSuccessor(const State &board, Visit &&visit) const
+    {
+        if (isGoal(board))
+            return;
+        int player = board.playerToMove();
+        for (uint32_t empty = board.emptyCells(); empty != 0; empty &= empty - 1)
+        {
+            int cell = __builtin_ctz(empty);
+            visit(board.marked(cell, player), cell);
+        }
+    }
+};
+
+#endif
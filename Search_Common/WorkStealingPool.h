@@ -0,0 +1,85 @@
+#ifndef WORK_STEALING_POOL_H
+#define WORK_STEALING_POOL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Runs run(task, worker) for every task in [0, taskCount) on threadCount
+// workers. Each worker starts with a contiguous block of task indices and
+// takes them from the front; a worker that runs dry steals the back half of
+// another worker's remaining block, trying the next worker along first.
+// Tasks should be coarse (a lock is taken per task), and no task is run
+// twice. The calling thread is worker 0.
+template <class Run>
+void runWorkStealing(size_t taskCount, int threadCount, Run run)
+{
+    // One cache line per worker so owners and thieves of different blocks
+    // never contend on the same line
+    struct alignas(64) Block
+    {
+        std::mutex lock;
+        size_t begin = 0;
+        size_t end = 0;
+    };
+
+    threadCount = std::max(threadCount, 1);
+    std::vector<Block> blocks(threadCount);
+    for (int id = 0; id < threadCount; id++)
+    {
+        blocks[id].begin = taskCount * id / threadCount;
+        blocks[id].end = taskCount * (id + 1) / threadCount;
+    }
+
+    auto worker = [&](int id)
+    {
+        Block &own = blocks[id];
+        for (;;)
+        {
+            size_t task;
+            {
+                std::lock_guard<std::mutex> guard(own.lock);
+                task = own.begin < own.end ? own.begin++ : taskCount;
+            }
+            if (task < taskCount)
+            {
+                run(task, id);
+                continue;
+            }
+
+            // Out of work: steal the back half of the first non-empty block
+            // found. Only one lock is held at a time.
+            size_t begin = 0, end = 0;
+            for (int step = 1; step < threadCount && begin == end; step++)
+            {
+                Block &victim = blocks[(id + step) % threadCount];
+                std::lock_guard<std::mutex> guard(victim.lock);
+                size_t take = (victim.end - victim.begin + 1) / 2;
+                begin = victim.end - take;
+                end = victim.end;
+                victim.end = begin;
+            }
+            // Tasks are never added, so one empty sweep means all are taken
+            if (begin == end)
+                return;
+            std::lock_guard<std::mutex> guard(own.lock);
+            own.begin = begin;
+            own.end = end;
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int id = 1; id < threadCount; id++)
+    {
+        threads.emplace_back(worker, id);
+    }
+    worker(0);
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+}
+
+#endif
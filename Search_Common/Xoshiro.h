@@ -0,0 +1,94 @@
+#ifndef XOSHIRO_H
+#define XOSHIRO_H
+
+#include <cstdint>
+
+// xoshiro256** generator (Blackman and Vigna): 32 bytes of state, a few
+// shifts and rotates per number, and no shared state, so each thread can
+// own one. Seeded through splitmix64, so nearby seeds give unrelated
+// streams; stream(master, i) derives thread i's seed from a master seed.
+class Xoshiro256
+{
+private:
+    uint64_t s[4];
+
+    static uint64_t rotl(uint64_t x, int k)
+    {
+        return (x << k) | (x >> (64 - k));
+    }
+
+public:
+    static uint64_t splitMix(uint64_t &x)
+    {
+        uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    explicit Xoshiro256(uint64_t seed = 0)
+    {
+        reseed(seed);
+    }
+
+    void reseed(uint64_t seed)
+    {
+        for (uint64_t &word : s)
+        {
+            word = splitMix(seed);
+        }
+    }
+
+    // Seed of the index-th stream under a master seed
+    static uint64_t stream(uint64_t master, uint64_t index)
+    {
+        uint64_t x = master ^ (index * 0xD1B54A32D192ED03ULL);
+        return splitMix(x);
+    }
+
+    // Usable as a standard random bit generator (std::shuffle and friends)
+    typedef uint64_t result_type;
+
+    static constexpr uint64_t min()
+    {
+        return 0;
+    }
+
+    static constexpr uint64_t max()
+    {
+        return UINT64_MAX;
+    }
+
+    uint64_t operator()()
+    {
+        return next();
+    }
+
+    uint64_t next()
+    {
+        uint64_t result = rotl(s[1] * 5, 7) * 9;
+        uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return result;
+    }
+
+    // Uniform in [0, bound), by multiply and shift (bias below 2^-32 for
+    // bounds under 2^32)
+    uint32_t below(uint32_t bound)
+    {
+        return uint32_t(((next() >> 32) * bound) >> 32);
+    }
+
+    // Uniform in [0, 1)
+    double uniform()
+    {
+        return (next() >> 11) * (1.0 / 9007199254740992.0);
+    }
+};
+
+#endif
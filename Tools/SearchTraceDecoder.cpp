@@ -0,0 +1,147 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <cstring>
+#include "../Search_Common/PackedPuzzle.h"
+#include "../Search_Common/SearchTrace.h"
+
+using namespace std;
+
+const char TIC_TAC_TOE_MARKS[3] = {'_', 'X', 'O'};
+
+// How each traced node was reached, indexed by node id, for rebuilding paths
+struct Step
+{
+    uint32_t parent = UINT32_MAX;
+    int move = -1;
+};
+
+string moveName(const TraceHeader &header, int move)
+{
+    if (header.stateKind == TRACE_STATE_PUZZLE)
+        return string(1, PUZZLE_MOVE_NAMES[move & 3]);
+    if (header.stateKind == TRACE_STATE_QUEENS)
+        return to_string(move / header.width) + ":" + to_string(move % header.width);
+    return to_string(move);
+}
+
+// Moves from the root to `node`, as far as the trace knows its ancestors
+string pathTo(const TraceHeader &header, const vector<Step> &steps, uint32_t node)
+{
+    vector<int> moves;
+    while (node < steps.size() && steps[node].move >= 0)
+    {
+        moves.push_back(steps[node].move);
+        node = steps[node].parent;
+    }
+    string path;
+    for (size_t i = moves.size(); i-- > 0;)
+    {
+        path += moveName(header, moves[i]);
+        if (i > 0)
+            path += " ";
+    }
+    return path;
+}
+
+void printState(const TraceHeader &header, uint64_t word)
+{
+    int width = header.width;
+    switch (header.stateKind)
+    {
+    case TRACE_STATE_PUZZLE:
+        for (int cell = 0; cell < width * width; cell++)
+        {
+            cout << ((word >> (4 * cell)) & 0xF) << " ";
+            if (cell % width == width - 1)
+                cout << endl;
+        }
+        break;
+    case TRACE_STATE_TIC_TAC_TOE:
+        for (int cell = 0; cell < 9; cell++)
+        {
+            cout << TIC_TAC_TOE_MARKS[(word >> cell & 1) ? 1 : (word >> (9 + cell) & 1) ? 2 : 0] << "|";
+            if (cell % 3 == 2)
+                cout << "\n-----\n";
+        }
+        break;
+    case TRACE_STATE_QUEENS:
+        for (int line = 0; line < width; line++)
+        {
+            int position = int((word >> (4 * line)) & 0xF) - 1;
+            for (int i = 0; i < width; i++)
+            {
+                cout << (i == position ? "Q " : ". ");
+            }
+            cout << endl;
+        }
+        break;
+    default:
+        printf("%016llx\n", (unsigned long long)word);
+        break;
+    }
+}
+
+// Usage: SearchTraceDecoder trace.bin [--summary]
+// Prints every traced node with its g, h, parent and path from the root;
+// --summary only counts records and reports the deepest g.
+int main(int argc, char *argv[])
+{
+    if (argc < 2)
+    {
+        cout << "Usage: SearchTraceDecoder trace.bin [--summary]" << endl;
+        return 1;
+    }
+    bool summary = argc > 2 && string(argv[2]) == "--summary";
+
+    FILE *file = fopen(argv[1], "rb");
+    if (file == nullptr)
+    {
+        cout << "Could not open " << argv[1] << endl;
+        return 1;
+    }
+
+    TraceHeader header;
+    if (fread(&header, sizeof(header), 1, file) != 1 || memcmp(header.magic, TRACE_MAGIC, 4) != 0 ||
+        header.version != TRACE_VERSION || header.recordSize != sizeof(TraceRecord))
+    {
+        cout << argv[1] << " is not a search trace of this version" << endl;
+        fclose(file);
+        return 1;
+    }
+
+    vector<Step> steps;
+    vector<TraceRecord> batch(4096);
+    uint64_t count = 0;
+    int deepest = 0;
+    size_t read;
+    while ((read = fread(batch.data(), sizeof(TraceRecord), batch.size(), file)) > 0)
+    {
+        for (size_t i = 0; i < read; i++)
+        {
+            const TraceRecord &entry = batch[i];
+            count++;
+            deepest = max(deepest, int(entry.g));
+            if (entry.node >= steps.size())
+                steps.resize(max<size_t>(entry.node + 1, steps.size() * 2));
+            steps[entry.node].parent = entry.parent;
+            steps[entry.node].move = entry.parent == UINT32_MAX ? -1 : entry.move;
+            if (summary)
+                continue;
+
+            cout << "Node " << entry.node << " (parent ";
+            if (entry.parent == UINT32_MAX)
+                cout << "none";
+            else
+                cout << entry.parent;
+            cout << "), g: " << entry.g << ", h: " << entry.h << endl;
+            printState(header, entry.state);
+            cout << "Path so far: " << pathTo(header, steps, entry.node) << "\n\n";
+        }
+    }
+    fclose(file);
+
+    cout << count << " records, deepest g " << deepest << endl;
+    return 0;
+}
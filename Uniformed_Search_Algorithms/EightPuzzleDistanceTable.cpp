@@ -0,0 +1,87 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <chrono>
+#include <cstring>
+#include "../Search_Common/PackedPuzzle.h"
+#include "../Search_Common/PermutationRank.h"
+#include "../Search_Common/StateBitmap.h"
+#include "../Search_Common/PuzzleDistanceTable.h"
+
+using namespace std;
+
+typedef PackedPuzzle<3> Board;
+
+// Retrograde BFS from the goal over all 9!/2 solvable boards. Every board is
+// reached at its optimal distance, which is stored mod 16 in its rank's nibble.
+vector<unsigned char> buildDistanceTable(int &maxDepth)
+{
+    uint64_t states = PuzzleRanking<3>::size();
+    vector<unsigned char> nibbles((states + 1) / 2, 0);
+    StateBitmap visited(states);
+
+    vector<Board> frontier = {Board::goal()};
+    vector<Board> next;
+    visited.testAndSet(PuzzleRanking<3>::rank(Board::goal()));
+
+    int depth = 0;
+    uint64_t reached = 1;
+    while (!frontier.empty())
+    {
+        cout << "Depth " << depth << ": " << frontier.size() << " states\n";
+        next.clear();
+        for (const Board &board : frontier)
+        {
+            for (int move = 0; move < 4; move++)
+            {
+                int target = Board::targetCell(board.blank(), move);
+                if (target < 0)
+                    continue;
+
+                Board successor = board.movedTo(target);
+                uint64_t index = PuzzleRanking<3>::rank(successor);
+                if (!visited.testAndSet(index))
+                {
+                    nibbles[index >> 1] |= ((depth + 1) & 0xF) << ((index & 1) * 4);
+                    next.push_back(successor);
+                }
+            }
+        }
+        reached += next.size();
+        frontier.swap(next);
+        depth++;
+    }
+
+    maxDepth = depth - 1;
+    cout << "Reached " << reached << " of " << states << " states\n";
+    return nibbles;
+}
+
+int main(int argc, char *argv[])
+{
+    const char *path = argc > 1 ? argv[1] : "EightPuzzleDistances.bin";
+
+    cout << "Building 8-puzzle distance table...\n";
+    auto start = chrono::steady_clock::now();
+    int maxDepth = 0;
+    vector<unsigned char> nibbles = buildDistanceTable(maxDepth);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << "Longest optimal solution: " << maxDepth << " moves, built in " << seconds << " s\n";
+
+    DistanceTableHeader header;
+    memcpy(header.magic, DISTANCE_TABLE_MAGIC, 4);
+    header.width = 3;
+    header.states = PuzzleRanking<3>::size();
+
+    ofstream out(path, ios::binary);
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char *>(nibbles.data()), nibbles.size());
+    if (!out)
+    {
+        cout << "Failed to write " << path << endl;
+        return 1;
+    }
+
+    cout << "Wrote " << sizeof(header) + nibbles.size() << " bytes to " << path << endl;
+    return 0;
+}
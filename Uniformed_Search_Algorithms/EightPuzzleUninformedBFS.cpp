@@ -1,144 +1,232 @@
 #include <iostream>
 #include <vector>
-#include <queue>
-#include <set>
 #include <algorithm>
 #include <string>
+#include "../Search_Common/PackedPuzzle.h"
+#include "../Search_Common/PermutationRank.h"
+#include "../Search_Common/StateBitmap.h"
+#include "../Search_Common/PuzzleDistanceTable.h"
+#include "../Search_Common/Search.h"
+#include "../Search_Common/SlidingPuzzleProblem.h"
+#include "../Search_Common/SearchTrace.h"
 
 using namespace std;
 
+typedef PackedPuzzle<3> Board;
+
 struct State
 {
-    vector<vector<int>> board;
-    int zeroX, zeroY;
-    string path;
+    Board board;      // 3x3 board packed into one 64-bit word
+    vector<int> path; // moves from the start, filled in once a solution is known
 
-    State(vector<vector<int>> b, int x, int y, string p)
-        : board(b), zeroX(x), zeroY(y), path(p) {}
+    State(Board b) : board(b) {}
 
     bool isGoal() const
     {
-        return board == vector<vector<int>>{{1, 2, 3},
-                                            {4, 5, 6},
-                                            {7, 8, 0}};
+        return board.isGoal();
     }
 
-    void print() const
+    // Slides the tiles and records each move in the path
+    void play(const vector<int> &moves)
     {
-        cout << "\nFinal state:\n";
-        for (const auto &row : board)
+        for (int move : moves)
         {
-            for (int val : row)
-            {
-                cout << val << " ";
-            }
-            cout << endl;
+            path.push_back(move);
+            board = board.movedTo(Board::targetCell(board.blank(), move));
         }
-        cout << "\nSolution path: " << path;
-        cout << "\nNumber of moves: " << (path.empty() ? 0 : count(path.begin(), path.end(), ' ') + 1) << endl;
     }
-};
 
-string boardToString(const vector<vector<int>> &board)
-{
-    string result;
-    for (const auto &row : board)
+    void print() const
     {
-        for (int val : row)
+        cout << "\nFinal state:\n";
+        for (int cell = 0; cell < Board::CELLS; cell++)
         {
-            result += to_string(val);
+            cout << board.tileAt(cell) << " ";
+            if (cell % 3 == 2)
+                cout << endl;
         }
+        cout << "\nSolution path: " << movesToString(path, " ");
+        cout << "\nNumber of moves: " << path.size() << endl;
     }
-    return result;
-}
+};
 
-vector<State> getSuccessors(const State &current)
+typedef SlidingPuzzleProblem<3> Problem;
+
+// Down, Up, Right, Left
+const int BFS_MOVE_ORDER[4] = {MOVE_DOWN, MOVE_UP, MOVE_RIGHT, MOVE_LEFT};
+
+// With `trace` open, every explored state goes to it as a binary record
+// (decode with Tools/SearchTraceDecoder); otherwise nothing is written
+// while searching. The caller closes the trace.
+bool bfs(const State &initialState, TraceWriter &trace)
 {
-    vector<State> successors;
-    vector<pair<int, int>> moves = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}}; // Down, Up, Right, Left
-    vector<string> moveNames = {"D", "U", "R", "L"};
+    Problem problem(BFS_MOVE_ORDER);
+    Search<Problem> search(problem);
 
-    for (int i = 0; i < moves.size(); i++)
-    {
-        int newX = current.zeroX + moves[i].first;
-        int newY = current.zeroY + moves[i].second;
+    uint32_t goal = trace.isOpen()
+                        ? search.breadthFirst(initialState.board, AcceptGoal(), traceExpansions(problem, search.arena(), trace))
+                        : search.breadthFirst(initialState.board);
+
+    if (goal == Search<Problem>::NO_NODE)
+        return false;
 
-        if (newX >= 0 && newX < 3 && newY >= 0 && newY < 3)
+    State solved = initialState;
+    solved.play(search.movesTo(goal));
+    solved.print();
+    cout << "States explored: " << search.nodesExpanded() << endl;
+    cout << "Peak queue size: " << search.peakOpenSize() << " states" << endl;
+    return true;
+}
+
+// Per-side record for bidirectional search: depth << 2 | move that reached the board
+const uint8_t NOT_REACHED = 255;
+
+// Expands one whole layer of `frontier`. New boards get their depth and move
+// recorded in `reached`; boards already reached from the other side are
+// meeting points, and the one with the shortest total path is kept.
+void expandLayer(vector<Board> &frontier, vector<uint8_t> &reached, const vector<uint8_t> &otherReached,
+                 int &bestLength, Board &meeting, uint64_t &statesExplored)
+{
+    vector<Board> next;
+    for (const Board &board : frontier)
+    {
+        statesExplored++;
+        int depth = reached[PuzzleRanking<3>::rank(board)] >> 2;
+        for (int move = 0; move < 4; move++)
         {
-            vector<vector<int>> newBoard = current.board;
-            swap(newBoard[current.zeroX][current.zeroY],
-                 newBoard[newX][newY]);
+            int target = Board::targetCell(board.blank(), move);
+            if (target < 0)
+                continue;
 
-            string newPath = current.path;
-            if (!newPath.empty())
-                newPath += " ";
-            newPath += moveNames[i];
+            Board successor = board.movedTo(target);
+            uint64_t index = PuzzleRanking<3>::rank(successor);
+            if (reached[index] != NOT_REACHED)
+                continue;
+            reached[index] = uint8_t(((depth + 1) << 2) | move);
+            next.push_back(successor);
 
-            successors.push_back(State(newBoard, newX, newY, newPath));
+            if (otherReached[index] != NOT_REACHED)
+            {
+                int length = depth + 1 + (otherReached[index] >> 2);
+                if (bestLength < 0 || length < bestLength)
+                {
+                    bestLength = length;
+                    meeting = successor;
+                }
+            }
         }
     }
-    return successors;
+    frontier.swap(next);
 }
 
-bool bfs(const State &initialState)
+// Bidirectional BFS: one frontier grows from the start and one from the goal,
+// always expanding the smaller one, until they meet. The frontiers only have
+// to reach about half the solution depth each, so far fewer boards are touched.
+bool bidirectionalBfs(const State &initialState)
 {
-    queue<State> q;
-    set<string> visited;
+    uint64_t states = PuzzleRanking<3>::size();
+    if (!PuzzleRanking<3>::isSolvable(initialState.board))
+        return false;
 
-    q.push(initialState);
-    visited.insert(boardToString(initialState.board));
+    vector<uint8_t> forwardReached(states, NOT_REACHED), backwardReached(states, NOT_REACHED);
+    vector<Board> forward = {initialState.board}, backward = {Board::goal()};
+    forwardReached[PuzzleRanking<3>::rank(initialState.board)] = 0;
+    backwardReached[PuzzleRanking<3>::rank(Board::goal())] = 0;
 
-    int statesExplored = 0;
+    int bestLength = initialState.isGoal() ? 0 : -1;
+    Board meeting = initialState.board;
+    uint64_t statesExplored = 0;
+    size_t peakFrontier = 2;
 
-    while (!q.empty())
+    // Finishing the layer in which the frontiers first meet is enough to
+    // guarantee the shortest connection has been seen
+    while (bestLength < 0 && !forward.empty() && !backward.empty())
     {
-        State current = q.front();
-        q.pop();
-        statesExplored++;
+        if (forward.size() <= backward.size())
+            expandLayer(forward, forwardReached, backwardReached, bestLength, meeting, statesExplored);
+        else
+            expandLayer(backward, backwardReached, forwardReached, bestLength, meeting, statesExplored);
+        peakFrontier = max(peakFrontier, forward.size() + backward.size());
+    }
+    if (bestLength < 0)
+        return false;
 
-        // Debug print current state
-        cout << "Exploring state:\n";
-        for (const auto &row : current.board)
-        {
-            for (int val : row)
-            {
-                cout << val << " ";
-            }
-            cout << endl;
-        }
-        cout << "Path so far: " << current.path << "\n\n";
+    // Walk back from the meeting point to the start, then on to the goal
+    vector<int> moves;
+    for (Board board = meeting; board != initialState.board;)
+    {
+        int move = forwardReached[PuzzleRanking<3>::rank(board)] & 3;
+        moves.push_back(move);
+        board = board.movedTo(Board::targetCell(board.blank(), move ^ 1));
+    }
+    reverse(moves.begin(), moves.end());
+    for (Board board = meeting; !board.isGoal();)
+    {
+        int move = (backwardReached[PuzzleRanking<3>::rank(board)] & 3) ^ 1;
+        moves.push_back(move);
+        board = board.movedTo(Board::targetCell(board.blank(), move));
+    }
 
-        if (current.isGoal())
-        {
-            current.print();
-            cout << "States explored: " << statesExplored << endl;
-            return true;
-        }
+    State current = initialState;
+    current.play(moves);
+    current.print();
+    cout << "States explored: " << statesExplored << endl;
+    cout << "Peak frontier size: " << peakFrontier << " states ("
+         << peakFrontier * sizeof(Board) + 2 * states << " bytes with both depth/move arrays)" << endl;
+    return true;
+}
 
-        vector<State> successors = getSuccessors(current);
-        for (const State &successor : successors)
-        {
-            string boardStr = boardToString(successor.board);
-            if (visited.find(boardStr) == visited.end())
-            {
-                visited.insert(boardStr);
-                q.push(successor);
-            }
-        }
+// Answers a solve from the precomputed distance table instead of searching.
+// The table is built by EightPuzzleDistanceTable.cpp and mapped read-only.
+bool solveWithTable(const State &initialState, const char *tablePath)
+{
+    PuzzleDistanceTable<3> table;
+    if (!table.load(tablePath))
+    {
+        cout << "Could not load distance table " << tablePath << endl;
+        return false;
+    }
+
+    vector<int> moves;
+    if (!table.solve(initialState.board, moves))
+    {
+        return false;
     }
 
-    return false;
+    State current = initialState;
+    current.play(moves);
+    current.print();
+    return true;
 }
 
-int main()
+// Usage: EightPuzzleUninformedBFS [--bidirectional | --table [EightPuzzleDistances.bin]
+//                                  | --trace file]
+int main(int argc, char *argv[])
 {
+    bool useTable = argc > 1 && string(argv[1]) == "--table";
+    bool bidirectional = argc > 1 && string(argv[1]) == "--bidirectional";
+    const char *tablePath = argc > 2 ? argv[2] : "EightPuzzleDistances.bin";
+
+    bool traced = argc > 1 && string(argv[1]) == "--trace";
+    if (traced && argc < 3)
+    {
+        cout << "Usage: EightPuzzleUninformedBFS [--bidirectional | --table [EightPuzzleDistances.bin] | --trace file]"
+             << endl;
+        return 1;
+    }
+    TraceWriter trace;
+    if (traced && !trace.open(argv[2], TRACE_STATE_PUZZLE, 3))
+    {
+        cout << "Could not write trace " << argv[2] << endl;
+        return 1;
+    }
+
     vector<vector<int>> initialBoard = {
         {1, 2, 3},
         {4, 5, 6},
         {7, 0, 8}};
 
-    // Empty tile is at (2, 1)
-    State initialState(initialBoard, 2, 1, "");
+    State initialState(Board::fromBoard(initialBoard));
 
     cout << "Initial state:\n";
     for (const auto &row : initialBoard)
@@ -149,12 +237,39 @@ int main()
         }
         cout << endl;
     }
+    if (useTable)
+    {
+        cout << "\nLooking up solution in distance table...\n";
+        if (!solveWithTable(initialState, tablePath))
+        {
+            cout << "No solution found." << endl;
+        }
+        return 0;
+    }
+
+    if (bidirectional)
+    {
+        cout << "\nSearching for solution using bidirectional BFS...\n";
+        if (!bidirectionalBfs(initialState))
+        {
+            cout << "No solution found." << endl;
+        }
+        return 0;
+    }
+
     cout << "\nSearching for solution using BFS...\n\n";
 
-    if (!bfs(initialState))
+    if (!bfs(initialState, trace))
     {
         cout << "No solution found." << endl;
     }
+    if (traced && !trace.close())
+    {
+        cout << "Could not write trace " << argv[2] << ": it is incomplete" << endl;
+        return 1;
+    }
+    if (traced)
+        cout << "Trace written to " << argv[2] << " (" << trace.recordCount() << " records)" << endl;
 
     return 0;
 }
\ No newline at end of file
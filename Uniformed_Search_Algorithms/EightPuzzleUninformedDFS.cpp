@@ -1,141 +1,62 @@
 #include <iostream>
 #include <vector>
-#include <set>
-#include <stack>
-#include <algorithm>
 #include <string>
+#include "../Search_Common/PackedPuzzle.h"
+#include "../Search_Common/PermutationRank.h"
+#include "../Search_Common/Search.h"
+#include "../Search_Common/SlidingPuzzleProblem.h"
 
 using namespace std;
 
+typedef PackedPuzzle<3> Board;
+
 struct State
 {
-    vector<vector<int>> board; // 3x3 board representation
-    int zeroX, zeroY;          // Position of the empty tile (0)
-    string path;               // Path taken to reach this state
+    Board board;      // 3x3 board packed into one 64-bit word
+    vector<int> path; // Path taken to reach this state
 
-    State(vector<vector<int>> b, int x, int y, string p)
-        : board(b), zeroX(x), zeroY(y), path(p) {}
+    State(Board b, const vector<int> &p = vector<int>())
+        : board(b), path(p) {}
 
     // Check if this state is the goal state
     bool isGoal() const
     {
-        return board == vector<vector<int>>{{1, 2, 3},
-                                            {4, 5, 6},
-                                            {7, 8, 0}};
+        return board.isGoal();
     }
 
-    // Print the board
+    // Print the board and the path as move letters
     void print() const
     {
-        for (const auto &row : board)
+        for (int cell = 0; cell < Board::CELLS; cell++)
         {
-            for (int val : row)
-            {
-                cout << val << " ";
-            }
-            cout << endl;
+            cout << board.tileAt(cell) << " ";
+            if (cell % 3 == 2)
+                cout << endl;
         }
-        cout << "Path: " << path << endl;
+        cout << "Path: " << movesToString(path, " ") << endl;
     }
 };
 
-// Function to convert board to string for visited set
-string boardToString(const vector<vector<int>> &board)
-{
-    string result;
-    for (const auto &row : board)
-    {
-        for (int val : row)
-        {
-            result += to_string(val);
-        }
-    }
-    return result;
-}
-
-// Function to get move direction as string
-string getMoveDirection(int dx, int dy)
-{
-    if (dx == 1)
-        return "D";
-    if (dx == -1)
-        return "U";
-    if (dy == 1)
-        return "R";
-    return "L";
-}
-
-// Function to get all possible moves from the current state
-vector<State> getSuccessors(const State &current)
-{
-    vector<State> successors;
-    // Down, Up, Right, Left
-    vector<pair<int, int>> moves = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
-
-    for (const auto &move : moves)
-    {
-        int dx = move.first;
-        int dy = move.second;
-
-        int newX = current.zeroX + dx;
-        int newY = current.zeroY + dy;
+typedef SlidingPuzzleProblem<3> Problem;
 
-        // Check if the new position is within bounds
-        if (newX >= 0 && newX < 3 && newY >= 0 && newY < 3)
-        {
-            // Create a new board configuration
-            vector<vector<int>> newBoard = current.board;
-            swap(newBoard[current.zeroX][current.zeroY],
-                 newBoard[newX][newY]);
-
-            // Add move direction to path
-            string newPath = current.path;
-            if (!newPath.empty())
-                newPath += " ";
-            newPath += getMoveDirection(dx, dy);
-
-            successors.emplace_back(newBoard, newX, newY, newPath);
-        }
-    }
-    return successors;
-}
+// Successors are expanded in this order: Left, Right, Up, Down
+const int DFS_MOVE_ORDER[4] = {MOVE_LEFT, MOVE_RIGHT, MOVE_UP, MOVE_DOWN};
 
 // DFS Algorithm
 bool dfs(const State &initialState)
 {
-    stack<State> s;
-    set<string> visited; // To keep track of visited states using string representation
-
-    s.push(initialState);
-    visited.insert(boardToString(initialState.board));
-
-    while (!s.empty())
-    {
-        State current = s.top();
-        s.pop();
-
-        // Check if we reached the goal state
-        if (current.isGoal())
-        {
-            cout << "Solution found!\n";
-            current.print();
-            return true;
-        }
-
-        // Generate successors and add them to the stack
-        vector<State> successors = getSuccessors(current);
-        for (const State &successor : successors)
-        {
-            string boardStr = boardToString(successor.board);
-            if (visited.find(boardStr) == visited.end())
-            {
-                visited.insert(boardStr);
-                s.push(successor);
-            }
-        }
-    }
-
-    return false;
+    Problem problem(DFS_MOVE_ORDER);
+    Search<Problem> search(problem); // One bit per solvable board, indexed by rank
+
+    uint32_t goal = search.depthFirst(initialState.board);
+    if (goal == Search<Problem>::NO_NODE)
+        return false;
+
+    // Path read off the parent links
+    State solved(search.arena().state(goal), search.movesTo(goal));
+    cout << "Solution found!\n";
+    solved.print();
+    return true;
 }
 
 int main()
@@ -148,7 +69,7 @@ int main()
     };
 
     // Create the initial state
-    State initialState(initialBoard, 2, 0, "");
+    State initialState(Board::fromBoard(initialBoard));
 
     cout << "Initial state:\n";
     initialState.print();
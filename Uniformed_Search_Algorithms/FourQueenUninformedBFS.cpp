@@ -1,86 +1,93 @@
+#include <algorithm>
 #include <iostream>
 #include <vector>
-#include <queue>
+#include <string>
+#include <cstdlib>
+#include "../Search_Common/Search.h"
+#include "../Search_Common/QueensProblem.h"
+#include "../Search_Common/QueensSymmetry.h"
 
 using namespace std;
 
-// Structure to represent the state of the board
-struct State
+// Queens are placed row by row (queens.at(i) is the column of the queen in
+// row i), only on squares no earlier queen attacks. With `firstHalf`, the
+// first queen is kept in the left half of its row (the middle included).
+struct RowByRowProblem : QueensPlacementProblem
 {
-    vector<int> queens; // Positions of queens in rows
-    int row;            // Current row to place the next queen
+    bool firstHalf;
 
-    State(vector<int> q, int r) : queens(q), row(r) {}
-};
+    RowByRowProblem(int size, bool half) : QueensPlacementProblem(size), firstHalf(half) {}
 
-// Function to check if placing a queen at (row, col) is safe
-bool isSafe(const vector<int> &queens, int row, int col)
-{
-    for (int i = 0; i < row; i++)
+    template <class Visit>
+    void forEachSuccessor(const State &queens, Visit &&visit) const
     {
-        // Check for column and diagonal conflicts
-        if (queens[i] == col ||
-            queens[i] - i == col - row ||
-            queens[i] + i == col + row)
-        {
-            return false;
-        }
+        bool firstRow = placedCount(queens) == 0;
+        QueensPlacementProblem::forEachSuccessor(queens, [&](const State &next, int col)
+                                                 {
+            if (!firstHalf || !firstRow || col <= (n - 1) / 2)
+                visit(next, col); });
     }
-    return true;
-}
+};
 
-// Function to solve the N-Queens problem using Uninformed BFS
-void bfs(int n)
+// Function to solve the N-Queens problem using Uninformed BFS. With
+// `unique`, only one solution per class under rotation and reflection is
+// printed, with the number of solutions it stands for: the first queen is
+// kept in the left half of its row, and complete boards that are not
+// canonical are dropped.
+void bfs(int n, bool unique = false)
 {
-    queue<State> q;                   // Queue to hold the states
-    vector<int> initialQueens(n, -1); // Initialize queen positions
-    q.push(State(initialQueens, 0));  // Start with an empty board
-
-    while (!q.empty())
-    {
-        State currentState = q.front(); // Get the current state
-        q.pop();
+    RowByRowProblem problem(n, unique);
+    Search<RowByRowProblem> search(problem);
 
-        // If all queens are placed, print the solution
-        if (currentState.row == n)
+    // Every complete board is a solution: print it and keep searching
+    search.breadthFirst(PackedQueens(), [&](uint32_t node)
+                        {
+        vector<int> queens = search.arena().state(node).toVector(n);
+        int multiplicity = unique ? queensMultiplicity(queens.data(), n) : 1;
+        if (multiplicity == 0)
+            return false;
+        for (int i = 0; i < n; i++)
         {
-            for (int i = 0; i < n; i++)
+            for (int j = 0; j < n; j++)
             {
-                for (int j = 0; j < n; j++)
+                if (queens[i] == j)
                 {
-                    if (currentState.queens[i] == j)
-                    {
-                        cout << "Q ";
-                    }
-                    else
-                    {
-                        cout << ". ";
-                    }
+                    cout << "Q ";
+                }
+                else
+                {
+                    cout << ". ";
                 }
-                cout << endl;
-            }
-            cout << "------" << endl; // Separator between solutions
-            continue;                 // Go to the next state
-        }
-
-        // Generate successors for the current state
-        for (int col = 0; col < n; col++)
-        {
-            if (isSafe(currentState.queens, currentState.row, col))
-            {
-                vector<int> newQueens = currentState.queens;
-                newQueens[currentState.row] = col;              // Place the queen
-                q.push(State(newQueens, currentState.row + 1)); // Move to the next row
             }
+            cout << endl;
         }
-    }
+        if (unique)
+            cout << "(stands for " << multiplicity << " solutions)" << endl;
+        cout << "------" << endl; // Separator between solutions
+        return false; });
 }
 
-int main()
+// Usage: FourQueenUninformedBFS [n] [--unique]
+int main(int argc, char *argv[])
 {
     int n = 4; // Size of the board (4 for the 4-Queens problem)
+    bool unique = false;
+    for (int i = 1; i < argc; i++)
+    {
+        string arg = argv[i];
+        if (arg == "--unique")
+            unique = true;
+        else
+            n = atoi(argv[i]);
+    }
+    int maxN = min(PACKED_QUEENS_MAX, QUEENS_SYMMETRY_MAX);
+    if (n < 1 || n > maxN)
+    {
+        cout << "Board size must be between 1 and " << maxN << endl;
+        return 1;
+    }
     cout << "Solving " << n << "-Queens problem using Uninformed BFS...\n";
-    bfs(n); // Start the BFS to solve the problem
+    bfs(n, unique); // Start the BFS to solve the problem
     cout << "Finished." << endl;
     return 0;
 }
@@ -1,5 +1,11 @@
 #include <iostream>
 #include <vector>
+#include <string>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+#include <cstdlib>
+#include "../Search_Common/BitboardQueens.h"
 
 using namespace std;
 
@@ -8,59 +14,57 @@ class NQueens
 private:
     int size;                      // Size of the chessboard (4 for 4-Queens)
     vector<vector<int>> solutions; // To store all possible solutions
+    vector<int> multiplicities;    // Solutions each one stands for (unique mode)
 
-    // Function to check if it's safe to place a queen at (row, col)
-    bool isSafe(const vector<int> &queens, int row, int col)
+public:
+    NQueens(int n) : size(n) {}
+
+    // Function to solve the N-Queens problem using DFS: queens are placed
+    // row by row on safe squares, columns tried from left to right, with
+    // the taken columns and diagonals kept as bitmasks
+    void solve()
     {
-        for (int i = 0; i < row; i++)
-        {
-            // Check column and diagonal conflicts
-            if (queens[i] == col ||
-                queens[i] - i == col - row ||
-                queens[i] + i == col + row)
-            {
-                return false;
-            }
-        }
-        return true;
+        BitboardQueens queens(size);
+        queens.forEachSolution([&](const int *columns)
+                               {
+            solutions.push_back(vector<int>(columns, columns + size)); // Found a solution
+            return true; });
     }
 
-    // Recursive DFS function to place queens
-    void dfs(vector<int> &queens, int row)
+    // Only one solution of each class equal under rotation and reflection,
+    // with the size of its class
+    void solveUnique()
     {
-        if (row == size)
-        {
-            solutions.push_back(queens); // Found a solution
-            return;
-        }
-
-        for (int col = 0; col < size; col++)
-        {
-            if (isSafe(queens, row, col))
-            {
-                queens[row] = col;    // Place the queen
-                dfs(queens, row + 1); // Move to the next row
-                // Backtrack (no need to explicitly remove the queen)
-            }
-        }
+        BitboardQueens queens(size);
+        queens.forEachFundamentalSolution([&](const int *columns, int multiplicity)
+                                          {
+            solutions.push_back(vector<int>(columns, columns + size));
+            multiplicities.push_back(multiplicity);
+            return true; });
     }
 
-public:
-    NQueens(int n) : size(n) {}
+    // Fundamental solutions, and all solutions in `total`
+    uint64_t countUnique(uint64_t &total) const
+    {
+        BitboardQueens queens(size);
+        return queens.countFundamental(total);
+    }
 
-    // Function to solve the N-Queens problem using DFS
-    void solve()
+    // Counts the solutions without storing any. With several threads the
+    // tree is split at prefixDepth (0 picks it) into independent subtrees
+    // shared out by work stealing.
+    uint64_t count(int threads = 1, int prefixDepth = 0) const
     {
-        vector<int> queens(size, -1); // Initialize queen positions
-        dfs(queens, 0);               // Start DFS from the first row
+        BitboardQueens queens(size);
+        return threads > 1 ? queens.countParallel(threads, prefixDepth) : queens.count();
     }
 
     // Function to print all solutions
     void printSolutions() const
     {
-        for (const auto &solution : solutions)
+        for (size_t s = 0; s < solutions.size(); s++)
         {
-            for (int col : solution)
+            for (int col : solutions[s])
             {
                 for (int i = 0; i < size; i++)
                 {
@@ -75,18 +79,72 @@ public:
                 }
                 cout << endl;
             }
+            if (s < multiplicities.size())
+                cout << "(stands for " << multiplicities[s] << " solutions)" << endl;
             cout << "------" << endl;
         }
     }
 };
 
-int main()
+// Usage: FourQueenUninformedDFS [n] [--unique] [--count [--threads t] [--prefix depth]]
+// --count reports the number of solutions (boards up to 32 x 32) instead of
+// printing them, on t threads (default: all cores). --unique keeps one
+// solution per class under rotation and reflection, and says how many
+// solutions each stands for.
+int main(int argc, char *argv[])
 {
     int n = 4; // Size of the board (4 for the 4-Queens problem)
+    bool countOnly = false;
+    bool unique = false;
+    int threads = max(1, int(thread::hardware_concurrency()));
+    int prefixDepth = 0;
+    for (int i = 1; i < argc; i++)
+    {
+        string arg = argv[i];
+        if (arg == "--count")
+            countOnly = true;
+        else if (arg == "--unique")
+            unique = true;
+        else if (arg == "--threads" && i + 1 < argc)
+            threads = max(1, atoi(argv[++i]));
+        else if (arg == "--prefix" && i + 1 < argc)
+            prefixDepth = atoi(argv[++i]);
+        else
+            n = atoi(argv[i]);
+    }
+    if (n < 1 || n > BitboardQueens::MAX_SIZE)
+    {
+        cout << "Board size must be between 1 and " << BitboardQueens::MAX_SIZE << endl;
+        return 1;
+    }
     NQueens nQueens(n);
 
+    if (countOnly && unique)
+    {
+        auto start = chrono::steady_clock::now();
+        uint64_t total;
+        uint64_t fundamental = nQueens.countUnique(total);
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        cout << n << "-Queens has " << fundamental << " fundamental solutions, " << total
+             << " in all (" << seconds << " s)" << endl;
+        return 0;
+    }
+
+    if (countOnly)
+    {
+        auto start = chrono::steady_clock::now();
+        uint64_t solutions = nQueens.count(threads, prefixDepth);
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        cout << n << "-Queens has " << solutions << " solutions (" << seconds << " s, "
+             << threads << (threads == 1 ? " thread)" : " threads)") << endl;
+        return 0;
+    }
+
     cout << "Solving " << n << "-Queens problem using Uninformed DFS...\n";
-    nQueens.solve();
+    if (unique)
+        nQueens.solveUnique();
+    else
+        nQueens.solve();
     nQueens.printSolutions(); // Print all found solutions
 
     cout << "Finished." << endl;
@@ -0,0 +1,160 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <thread>
+#include <cstdlib>
+#include "../Search_Common/PackedPuzzle.h"
+#include "../Search_Common/PermutationRank.h"
+#include "../Search_Common/StateBitmap.h"
+#include "../Search_Common/PatternSpace.h"
+#include "../Search_Common/ParallelLayerBfs.h"
+
+using namespace std;
+
+typedef PackedPuzzle<3> Board;
+
+struct EnumerationResult
+{
+    vector<uint64_t> layerSizes;
+    uint64_t states;
+    double seconds;
+};
+
+// Every solvable 8-puzzle board, layer by layer from the goal. Frontiers
+// hold packed boards so successors are made without unranking.
+EnumerationResult enumerateEightPuzzle(int threadCount)
+{
+    AtomicStateBitmap visited(PuzzleRanking<3>::size());
+    Board goal = Board::goal();
+
+    EnumerationResult result;
+    auto start = chrono::steady_clock::now();
+    result.layerSizes = parallelLayerBfs({goal.word}, {PuzzleRanking<3>::rank(goal)}, visited, threadCount,
+                                         [](uint64_t state, auto &emit)
+                                         {
+                                             Board board(state);
+                                             for (int move = 0; move < 4; move++)
+                                             {
+                                                 int target = Board::targetCell(board.blank(), move);
+                                                 if (target < 0)
+                                                     continue;
+                                                 Board next = board.movedTo(target);
+                                                 emit(next.word, PuzzleRanking<3>::rank(next));
+                                             }
+                                         });
+    result.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+// The 15-puzzle abstracted to tiles 1..tileCount and the blank region, as
+// used for pattern databases. The full 16!/2 space does not fit a bitmap,
+// while a 7-tile pattern is 922M (placement, cell) pairs.
+EnumerationResult enumerateFifteenPuzzlePattern(int tileCount, int threadCount)
+{
+    int tiles[PDB_MAX_PATTERN_TILES];
+    int goalCell[16];
+    for (int i = 0; i < tileCount; i++)
+    {
+        tiles[i] = i + 1;
+    }
+    for (int tile = 0; tile < 16; tile++)
+    {
+        goalCell[tile] = tile;
+    }
+    PatternSpace space(4, tiles, tileCount, goalCell);
+    AtomicStateBitmap visited(space.size());
+    uint64_t goal = space.goalState();
+
+    EnumerationResult result;
+    auto start = chrono::steady_clock::now();
+    result.layerSizes = parallelLayerBfs({goal}, {goal}, visited, threadCount,
+                                         [&space](uint64_t state, auto &emit)
+                                         {
+                                             space.expand(state, [&emit](uint64_t next)
+                                                          { emit(next, next); });
+                                         });
+    result.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+EnumerationResult enumerate(int puzzle, int tileCount, int threadCount)
+{
+    EnumerationResult result = puzzle == 8 ? enumerateEightPuzzle(threadCount)
+                                           : enumerateFifteenPuzzlePattern(tileCount, threadCount);
+    result.states = 0;
+    for (uint64_t size : result.layerSizes)
+    {
+        result.states += size;
+    }
+    return result;
+}
+
+// Usage: ParallelLayerBFS [8 | 15 [pattern tiles]] [--threads n] [--sweep]
+// --sweep repeats the enumeration with 1, 2, 4, ... threads up to n and
+// checks that every run finds the same layers.
+int main(int argc, char *argv[])
+{
+    int puzzle = 8;
+    int tileCount = 6;
+    int threadCount = max(1u, thread::hardware_concurrency());
+    bool sweep = false;
+    vector<int> numbers;
+    for (int i = 1; i < argc; i++)
+    {
+        string arg = argv[i];
+        if (arg == "--threads" && i + 1 < argc)
+            threadCount = max(1, atoi(argv[++i]));
+        else if (arg == "--sweep")
+            sweep = true;
+        else
+            numbers.push_back(atoi(argv[i]));
+    }
+    if (!numbers.empty())
+        puzzle = numbers[0];
+    if (numbers.size() > 1)
+        tileCount = numbers[1];
+    if ((puzzle != 8 && puzzle != 15) || tileCount < 1 || tileCount > 8)
+    {
+        cout << "Usage: ParallelLayerBFS [8 | 15 [pattern tiles 1-8]] [--threads n] [--sweep]\n";
+        return 1;
+    }
+
+    if (puzzle == 8)
+        cout << "Parallel BFS over the 8-puzzle state space:\n";
+    else
+        cout << "Parallel BFS over the 15-puzzle abstracted to tiles 1-" << tileCount << ":\n";
+
+    vector<int> runs;
+    for (int threads = sweep ? 1 : threadCount; threads < threadCount; threads *= 2)
+    {
+        runs.push_back(threads);
+    }
+    runs.push_back(threadCount);
+
+    EnumerationResult first;
+    double baseline = 0;
+    for (size_t r = 0; r < runs.size(); r++)
+    {
+        EnumerationResult result = enumerate(puzzle, tileCount, runs[r]);
+        if (r == 0)
+        {
+            first = result;
+            baseline = result.seconds;
+            for (size_t depth = 0; depth < result.layerSizes.size(); depth++)
+            {
+                cout << "  depth " << depth << ": " << result.layerSizes[depth] << " states\n";
+            }
+        }
+        else if (result.layerSizes != first.layerSizes)
+        {
+            cout << "Layer sizes differ with " << runs[r] << " threads!" << endl;
+            return 1;
+        }
+
+        cout << runs[r] << " thread(s): " << result.states << " states, " << result.layerSizes.size()
+             << " layers, " << result.seconds << " s, " << result.states / max(result.seconds, 1e-9)
+             << " states/sec, speedup " << baseline / max(result.seconds, 1e-9) << endl;
+    }
+    return 0;
+}
@@ -1,7 +1,10 @@
 #include <iostream>
+#include <string>
 #include <vector>
-#include <queue>
-#include <unordered_map>
+#include "../Search_Common/Search.h"
+#include "../Search_Common/TicTacToeProblem.h"
+#include "../Search_Common/SearchTrace.h"
+#include "../Search_Common/TicTacToePerfectPlay.h"
 
 using namespace std;
 
@@ -9,169 +12,181 @@ const char EMPTY = '_';
 const char PLAYER_X = 'X';
 const char PLAYER_O = 'O';
 
-struct State
+char markChar(int mark)
 {
-    vector<vector<char>> board; // Current board state
-    char currentPlayer;         // X or O
-    int g;                      // Path cost (number of moves)
-    int h;                      // Heuristic cost
-
-    State(vector<vector<char>> b, char p, int g, int h)
-    {
-        this->board = b;
-        this->currentPlayer = p;
-        this->g = g;
-        this->h = h;
-    }
-
-    // Comparison operator for priority queue
-    bool operator<(const State &other) const
-    {
-        return (g + h) > other.g + other.h; // Min-heap based on f(n) = g + h
-    }
-};
+    return mark == TTT_X ? PLAYER_X : mark == TTT_O ? PLAYER_O : EMPTY;
+}
 
 // Function to print the board
-void printBoard(const vector<vector<char>> &board)
+void printBoard(const TicTacToeBoard &board)
 {
-    for (const auto &row : board)
+    for (int row = 0; row < 3; row++)
     {
-        for (char cell : row)
+        for (int col = 0; col < 3; col++)
         {
-            cout << cell << "|";
+            cout << markChar(board.at(row * 3 + col)) << "|";
         }
         cout << endl;
         cout << "-----\n";
     }
 }
 
-// Function to check if a player has won
-bool checkWin(const vector<vector<char>> &board, char player)
+// Heuristic function (number of potential wins for the player to move):
+// lines holding two of their marks and one empty cell
+int calculateHeuristic(const TicTacToeBoard &board, int player)
 {
-    for (int i = 0; i < 3; i++)
-    {
-        if (((board[i][0] == player && board[i][1] == player && board[i][2] == player) || // Rows
-             (board[0][i] == player && board[1][i] == player && board[2][i] == player)))  // Columns
-        {
-            return true;
-        }
-    }
-    // Check diagonals
-    if ((board[0][0] == player && board[1][1] == player && board[2][2] == player) ||
-        (board[0][2] == player && board[1][1] == player && board[2][0] == player))
+    uint32_t own = board.cells(player);
+    uint32_t empty = board.emptyCells();
+    int score = 0;
+    for (uint32_t line : TTT_LINE_MASKS)
     {
-        return true;
+        score += __builtin_popcount(own & line) == 2 && (empty & line) != 0;
     }
-    return false;
+    return score;
 }
 
-// Function to check if the game is over
-bool isGameOver(const vector<vector<char>> &board)
+// Game positions where a move places the mover's mark; the search stops at
+// the first position somebody has won
+struct TwoInARowProblem : TicTacToeProblem
 {
-    return checkWin(board, PLAYER_X) || checkWin(board, PLAYER_O);
-}
+    int heuristic(const TicTacToeBoard &board) const
+    {
+        return calculateHeuristic(board, board.playerToMove());
+    }
+};
 
-// Heuristic function (number of potential wins for the current player)
-int calculateHeuristic(const vector<vector<char>> &board, char player)
+// A* search algorithm for Tic-Tac-Toe. With `trace` open, every expanded
+// board goes to it as a binary record (decode with Tools/SearchTraceDecoder);
+// the caller closes it.
+void aStarSearch(TraceWriter &trace)
 {
-    int score = 0;
+    TwoInARowProblem problem;
+    Search<TwoInARowProblem> search(problem);
+    search.setBestFirstOrder(BEST_FIRST_HEAP); // ties as this program always broke them
+    const NodeArena<TicTacToeBoard> &nodes = search.arena();
+
+    // Start with X on the empty board
+    uint32_t goal = trace.isOpen()
+                        ? search.aStar(TicTacToeBoard(), AcceptGoal(), traceExpansions(problem, nodes, trace))
+                        : search.aStar(TicTacToeBoard());
 
-    // Rows and columns
-    for (int i = 0; i < 3; i++)
+    if (goal == Search<TwoInARowProblem>::NO_NODE)
     {
-        if (board[i][0] == player && board[i][1] == player && board[i][2] == EMPTY)
-            score++;
-        if (board[i][0] == player && board[i][2] == player && board[i][1] == EMPTY)
-            score++;
-        if (board[i][1] == player && board[i][2] == player && board[i][0] == EMPTY)
-            score++;
-
-        if (board[0][i] == player && board[1][i] == player && board[2][i] == EMPTY)
-            score++;
-        if (board[0][i] == player && board[2][i] == player && board[1][i] == EMPTY)
-            score++;
-        if (board[1][i] == player && board[2][i] == player && board[0][i] == EMPTY)
-            score++;
+        cout << "No more moves available. Game is a draw." << endl; // If the open list is exhausted
+        return;
     }
-
-    // Diagonals
-    if (board[0][0] == player && board[1][1] == player && board[2][2] == EMPTY)
-        score++;
-    if (board[0][0] == player && board[2][2] == player && board[1][1] == EMPTY)
-        score++;
-    if (board[1][1] == player && board[2][2] == player && board[0][0] == EMPTY)
-        score++;
-
-    if (board[0][2] == player && board[1][1] == player && board[2][0] == EMPTY)
-        score++;
-    if (board[0][2] == player && board[2][0] == player && board[1][1] == EMPTY)
-        score++;
-    if (board[1][1] == player && board[2][0] == player && board[0][2] == EMPTY)
-        score++;
-
-    return score;
+    cout << "Final Board:\n";
+    printBoard(nodes.state(goal));
+    cout << "Boards expanded: " << search.nodesExpanded() << endl;
+    cout << "Game Over. " << (nodes.state(goal).hasWon(TTT_X) ? PLAYER_X : PLAYER_O) << " wins!" << endl;
 }
 
-// Generate successor states for the current state
-vector<State> generateSuccessors(const State &currentState)
+// Both sides play the table's best move until the game ends
+void perfectGame()
 {
-    vector<State> successors;
-    char nextPlayer = (currentState.currentPlayer == PLAYER_X) ? PLAYER_O : PLAYER_X;
-
-    for (int i = 0; i < 3; i++)
+    TicTacToeBoard board;
+    cout << "Perfect play from the empty board (value for X: " << perfectValue(board) << ")\n";
+    while (!board.isGameOver())
     {
-        for (int j = 0; j < 3; j++)
-        {
-            if (currentState.board[i][j] == EMPTY)
-            {
-                vector<vector<char>> newBoard = currentState.board;
-                newBoard[i][j] = currentState.currentPlayer;
-                int h = calculateHeuristic(newBoard, nextPlayer);
-                successors.emplace_back(newBoard, nextPlayer, currentState.g + 1, h);
-            }
-        }
+        board = board.marked(perfectMove(board), board.playerToMove());
     }
-    return successors;
+    printBoard(board);
+    if (board.hasWon(TTT_X) || board.hasWon(TTT_O))
+        cout << "Game Over. " << (board.hasWon(TTT_X) ? PLAYER_X : PLAYER_O) << " wins!" << endl;
+    else
+        cout << "Game Over. It's a draw." << endl;
 }
 
-// A* search algorithm for Tic-Tac-Toe
-void aStarSearch()
+// Plain negamax over the whole game tree, no table; checks every position
+// it reaches against the compiled table. Returns the value for the player
+// to move.
+int checkPosition(const TicTacToeBoard &board, vector<bool> &reached, int &mismatches)
 {
-    priority_queue<State> pq;                                          // Min-heap
-    vector<vector<char>> initialBoard(3, vector<char>(3, EMPTY));      // Initial empty board
-    int initialHeuristic = calculateHeuristic(initialBoard, PLAYER_O); // Heuristic for O's turn
-    pq.emplace(initialBoard, PLAYER_X, 0, initialHeuristic);           // Start with X
-
-    while (!pq.empty())
+    reached[board.index()] = true;
+    int value = TTT_DRAW;
+    int bestChild = TTT_LOSS;
+    if (board.hasWon(TTT_X) || board.hasWon(TTT_O))
+        value = TTT_LOSS;
+    else if (board.markCount() < 9)
     {
-        State currentState = pq.top();
-        pq.pop();
-
-        // Print the current board state
-        cout << "Current Board:\n";
-        printBoard(currentState.board);
-        cout << "g: " << currentState.g << ", h: " << currentState.h << endl;
-
-        // Check if the game is over
-        if (isGameOver(currentState.board))
+        value = TTT_LOSS;
+        for (uint32_t empty = board.emptyCells(); empty != 0; empty &= empty - 1)
         {
-            cout << "Game Over. " << currentState.currentPlayer << " wins!" << endl;
-            return;
+            int cell = __builtin_ctz(empty);
+            int child = -checkPosition(board.marked(cell, board.playerToMove()), reached, mismatches);
+            value = max(value, child);
+            if (cell == perfectMove(board))
+                bestChild = child;
         }
+    }
 
-        // Generate successors and add them to the priority queue
-        vector<State> successors = generateSuccessors(currentState);
-        for (const State &successor : successors)
+    // The value must match, and the table's move must achieve it
+    bool moveOk = perfectMove(board) == TTT_NO_MOVE ? board.isGameOver() : bestChild == value;
+    if (!isLegalPosition(board) || perfectValue(board) != value || !moveOk)
+    {
+        if (mismatches++ < 10)
         {
-            pq.push(successor);
+            cout << "Table disagrees at position " << board.index() << " (solver " << value << ", table "
+                 << perfectValue(board) << ", move " << perfectMove(board) << ")\n";
         }
     }
-    cout << "No more moves available. Game is a draw." << endl; // If the queue is exhausted
+    return value;
 }
 
-int main()
+// Verifies the compiled table against a runtime solver
+bool selfCheck()
 {
+    vector<bool> reached(TTT_POSITIONS, false);
+    int mismatches = 0;
+    checkPosition(TicTacToeBoard(), reached, mismatches);
+
+    int reachedCount = 0, legalCount = 0;
+    for (int index = 0; index < TTT_POSITIONS; index++)
+    {
+        reachedCount += reached[index];
+        legalCount += (TTT_PERFECT.entries[index] & TicTacToePerfectTable::LEGAL) != 0;
+        if (reached[index] != ((TTT_PERFECT.entries[index] & TicTacToePerfectTable::LEGAL) != 0))
+            mismatches++;
+    }
+    cout << "Self-check: " << reachedCount << " positions reached, " << legalCount << " legal in the table, "
+         << mismatches << " mismatches" << endl;
+    return mismatches == 0;
+}
+
+// Usage: A_Star_TicTacToe [--trace file | --perfect | --self-check]
+// --perfect plays the game out from the compiled perfect-play table;
+// --self-check compares that table with a runtime negamax.
+int main(int argc, char *argv[])
+{
+    if (argc > 1 && string(argv[1]) == "--self-check")
+        return selfCheck() ? 0 : 1;
+    if (argc > 1 && string(argv[1]) == "--perfect")
+    {
+        perfectGame();
+        return 0;
+    }
+
+    bool traced = argc > 1 && string(argv[1]) == "--trace";
+    if (traced && argc < 3)
+    {
+        cout << "Usage: A_Star_TicTacToe [--trace file | --perfect | --self-check]" << endl;
+        return 1;
+    }
+    TraceWriter trace;
+    if (traced && !trace.open(argv[2], TRACE_STATE_TIC_TAC_TOE))
+    {
+        cout << "Could not write trace " << argv[2] << endl;
+        return 1;
+    }
+
     cout << "A* Search for Tic-Tac-Toe:\n";
-    aStarSearch();
+    aStarSearch(trace);
+    if (traced && !trace.close())
+    {
+        cout << "Could not write trace " << argv[2] << ": it is incomplete" << endl;
+        return 1;
+    }
+    if (traced)
+        cout << "Trace written to " << argv[2] << " (" << trace.recordCount() << " records)" << endl;
     return 0;
 }
@@ -0,0 +1,151 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cstdlib>
+#include "../Search_Common/SlidingPuzzleIDA.h"
+#include "../Search_Common/KorfInstances.h"
+#include "../Search_Common/PatternDatabase.h"
+#include "../Search_Common/RandomWalkBoard.h"
+
+using namespace std;
+
+// Print a board stored as cells in reading order
+template <int W>
+void printBoard(const int *board)
+{
+    for (int cell = 0; cell < W * W; cell++)
+    {
+        if (board[cell] < 10)
+            cout << " ";
+        cout << board[cell] << " ";
+        if (cell % W == W - 1)
+            cout << endl;
+    }
+}
+
+// Attach the pattern database when it was built for this board and goal
+template <int W>
+void attachPatternDatabase(SlidingPuzzleIDA<W> &solver, const PatternDatabase *pdb)
+{
+    if (pdb == nullptr)
+        return;
+    if (solver.usePatternDatabase(pdb))
+        cout << "Using pattern database heuristic\n";
+    else
+        cout << "Pattern database does not match this puzzle, using Manhattan distance\n";
+}
+
+template <int W>
+void solveAndReport(const int *board, const int *goal, const PatternDatabase *pdb)
+{
+    SlidingPuzzleIDA<W> solver(goal);
+    vector<int> solution;
+    attachPatternDatabase(solver, pdb);
+
+    printBoard<W>(board);
+    auto start = chrono::steady_clock::now();
+    bool solved = solver.solve(board, solution);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    if (!solved)
+    {
+        cout << "No solution found." << endl;
+        return;
+    }
+    cout << "Solution found in " << solution.size() << " moves: " << movesToString(solution) << endl;
+    cout << "Nodes generated: " << solver.nodesGenerated() << ", time: " << seconds << " s, "
+         << solver.nodesGenerated() / max(seconds, 1e-9) << " nodes/sec\n\n";
+}
+
+// Solves Korf's instances first..last (1-based) and reports totals
+bool runKorfInstances(int first, int last, const PatternDatabase *pdb)
+{
+    SlidingPuzzleIDA<4> solver(KORF_GOAL);
+    vector<int> solution;
+    attachPatternDatabase(solver, pdb);
+    uint64_t totalGenerated = 0;
+    bool allOptimal = true;
+
+    auto start = chrono::steady_clock::now();
+    for (int i = first; i <= last; i++)
+    {
+        auto instanceStart = chrono::steady_clock::now();
+        solver.solve(KORF_INSTANCES[i - 1], solution);
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - instanceStart).count();
+        totalGenerated += solver.nodesGenerated();
+
+        bool optimal = int(solution.size()) == KORF_OPTIMAL_LENGTHS[i - 1];
+        allOptimal = allOptimal && optimal;
+        cout << "Instance " << i << ": " << solution.size() << " moves"
+             << (optimal ? "" : " (expected " + to_string(KORF_OPTIMAL_LENGTHS[i - 1]) + ")")
+             << ", " << solver.nodesGenerated() << " nodes, " << seconds << " s" << endl;
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    cout << "\nSolved " << (last - first + 1) << " instances in " << seconds << " s\n";
+    cout << "Nodes generated: " << totalGenerated << ", " << totalGenerated / max(seconds, 1e-9) << " nodes/sec\n";
+    cout << (allOptimal ? "All solutions optimal." : "Some solutions were not optimal!") << endl;
+    return allOptimal;
+}
+
+// Korf instance number (1-based) from text; false unless it is a whole
+// number in range
+bool parseInstance(const string &text, int &instance)
+{
+    char *end = nullptr;
+    long value = strtol(text.c_str(), &end, 10);
+    if (text.empty() || *end != '\0' || value < 1 || value > KORF_INSTANCE_COUNT)
+        return false;
+    instance = int(value);
+    return true;
+}
+
+// Usage: IDA_Star_SlidingPuzzle [korf [first last]] [--pdb file]
+// Pattern databases come from PatternDatabaseGenerator and are mapped
+// read-only, so several solver processes share one copy.
+int main(int argc, char *argv[])
+{
+    vector<string> args;
+    PatternDatabase database;
+    const PatternDatabase *pdb = nullptr;
+    for (int i = 1; i < argc; i++)
+    {
+        if (string(argv[i]) == "--pdb" && i + 1 < argc)
+        {
+            if (!database.load(argv[++i]))
+            {
+                cout << "Could not load pattern database " << argv[i] << endl;
+                return 1;
+            }
+            pdb = &database;
+        }
+        else
+        {
+            args.push_back(argv[i]);
+        }
+    }
+
+    if (!args.empty() && args[0] == "korf")
+    {
+        int first = 1, last = KORF_INSTANCE_COUNT;
+        bool valid = args.size() == 1 ||
+                     (args.size() == 3 && parseInstance(args[1], first) && parseInstance(args[2], last) && first <= last);
+        if (!valid)
+        {
+            cout << "Usage: IDA_Star_SlidingPuzzle [korf [first last]] [--pdb file]\n"
+                 << "Korf instances are numbered 1 to " << KORF_INSTANCE_COUNT << ", first <= last\n";
+            return 1;
+        }
+        cout << "IDA* on Korf's 15-puzzle instances " << first << " to " << last << ":\n";
+        return runKorfInstances(first, last, pdb) ? 0 : 1;
+    }
+
+    cout << "IDA* Search for the 15-Puzzle (Korf instance 79):\n";
+    solveAndReport<4>(KORF_INSTANCES[78], KORF_GOAL, pdb != nullptr && pdb->width() == 4 ? pdb : nullptr);
+
+    cout << "IDA* Search for the 24-Puzzle:\n";
+    vector<int> board = randomWalkBoard<5>(60, 1);
+    solveAndReport<5>(board.data(), nullptr, pdb != nullptr && pdb->width() == 5 ? pdb : nullptr);
+    return 0;
+}
@@ -1,98 +1,40 @@
 #include <iostream>
-#include <queue>
-#include <cmath>
 #include <vector>
-#include <algorithm>
-#include <unordered_map>
+#include "../Search_Common/Search.h"
+#include "../Search_Common/QueensProblem.h"
 
 using namespace std;
 
-// States
-struct State
-{
-    vector<int> queens; // positions of queens in rows
-    int heuristicCost;
-
-    // Constructor
-    State(vector<int> q, int c)
-    {
-        this->queens = q;
-        this->heuristicCost = c;
-    }
-
-    // Operator overload for priority_queue (min-heap behavior)
-    bool operator<(const State &other) const
-    {
-        return this->heuristicCost > other.heuristicCost; // Min-heap
-    }
-};
+// States are complete boards (queens.at(col) is the row of that column's
+// queen); a move shifts one queen within its column and the heuristic cost
+// is the number of attacking pairs
+typedef QueensRepairProblem Problem;
 
-// Calculate heuristic cost based on conflicts
-int calculateHeuristicCost(const vector<int> &queens)
+// Informed BFS for N-Queens problem
+void informedBFS(int n)
 {
-    int conflicts = 0;
-    int n = queens.size();
-    for (int i = 0; i < n; i++)
-    {
-        for (int j = i + 1; j < n; j++)
-        {
-            // Same column or diagonal
-            if (queens[i] == queens[j] || abs(queens[i] - queens[j]) == abs(i - j)) // heuristic functions
-                conflicts++;
-        }
-    }
-    return conflicts;
-}
+    Problem problem(n);
+    Search<Problem> search(problem);
+    search.setBestFirstOrder(BEST_FIRST_HEAP); // ties as this program always broke them
 
-// Move queens in every configuration and calculate heuristic cost
-vector<State> generateSuccessors(const State &currentState)
-{
-    vector<State> successors;
-    int n = currentState.queens.size();
+    PackedQueens initialQueens; // All queens at row 0
     for (int col = 0; col < n; col++)
     {
-        for (int row = 0; row < n; row++)
-        {
-            if (currentState.queens[col] != row)
-            { // Change position
-                vector<int> newQueens = currentState.queens;
-                newQueens[col] = row;
-                int newHeuristicCost = calculateHeuristicCost(newQueens);
-                successors.push_back(State(newQueens, newHeuristicCost));
-            }
-        }
+        initialQueens = initialQueens.placed(col, 0);
     }
-    return successors; // Return generated successors
-}
 
-// Informed BFS for N-Queens problem
-void informedBFS(int n)
-{
-    priority_queue<State> pq;
-    vector<int> initialQueens(n, 0); // All queens at row 0
-    pq.push(State(initialQueens, calculateHeuristicCost(initialQueens)));
-
-    while (!pq.empty())
+    uint32_t goal = search.greedyBestFirst(initialQueens);
+    if (goal == Search<Problem>::NO_NODE)
     {
-        State currentState = pq.top();
-        pq.pop();
-
-        // Check if goal state
-        if (currentState.heuristicCost == 0)
-        {
-            cout << "Goal state found:" << endl;
-            for (int i = 0; i < n; i++)
-                cout << currentState.queens[i] << " "; // Output the solution
-            cout << endl;
-            return;
-        }
-
-        // Generate successors
-        vector<State> successors = generateSuccessors(currentState);
-        for (State &successor : successors)
-            pq.push(successor); // Push successor states into the priority queue
+        cout << "No solution found." << endl;
+        return;
     }
-    cout << "No solution found." << endl;
+
+    cout << "Goal state found:" << endl;
+    PackedQueens queens = search.arena().state(goal);
+    for (int i = 0; i < n; i++)
+        cout << queens.at(i) << " "; // Output the solution
+    cout << endl;
 }
 
 int main()
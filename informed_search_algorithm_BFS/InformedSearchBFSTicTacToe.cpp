@@ -1,7 +1,6 @@
 #include <iostream>
-#include <vector>
-#include <queue>
-#include <unordered_map>
+#include "../Search_Common/Search.h"
+#include "../Search_Common/TicTacToeProblem.h"
 
 using namespace std;
 
@@ -9,129 +8,58 @@ const char EMPTY = '_';
 const char PLAYER_X = 'X';
 const char PLAYER_O = 'O';
 
-struct State
-{
-    vector<vector<char>> board;
-    char currentPlayer; // X or O
-
-    // Constructor
-    State(const vector<vector<char>> &b, char p)
-    {
-        board = b;
-        currentPlayer = p;
-    }
-
-    // Operator overload for priority queue
-    bool operator<(const State &other) const
-    {
-        return false; // No comparison needed for BFS
-    }
-};
-
 // Function to print the Tic Tac Toe board
-void printBoard(const vector<vector<char>> &board)
+void printBoard(const TicTacToeBoard &board)
 {
-    for (const auto &row : board)
+    for (int row = 0; row < 3; row++)
     {
-        for (char cell : row)
+        for (int col = 0; col < 3; col++)
         {
-            cout << cell << "|";
+            int mark = board.at(row * 3 + col);
+            cout << (mark == TTT_X ? PLAYER_X : mark == TTT_O ? PLAYER_O : EMPTY) << "|";
         }
         cout << endl;
         cout << "-----\n";
     }
 }
 
-// Check if a player has won
-bool checkWin(const vector<vector<char>> &board, char player)
-{
-    for (int i = 0; i < 3; i++)
-    {
-        if ((board[i][0] == player && board[i][1] == player && board[i][2] == player) || // Rows
-            (board[0][i] == player && board[1][i] == player && board[2][i] == player))   // Columns
-        {
-            return true;
-        }
-    }
-    // Diagonals
-    if ((board[0][0] == player && board[1][1] == player && board[2][2] == player) ||
-        (board[0][2] == player && board[1][1] == player && board[2][0] == player))
-    {
-        return true;
-    }
-    return false;
-}
-
-// Check if the game is over (either win or draw)
-bool isGameOver(const vector<vector<char>> &board)
-{
-    return checkWin(board, PLAYER_X) || checkWin(board, PLAYER_O);
-}
-
-// Generate all possible next states (successors)
-vector<State> generateSuccessors(const State &currentState)
-{
-    vector<State> successors;
-    char nextPlayer = (currentState.currentPlayer == PLAYER_X) ? PLAYER_O : PLAYER_X;
-
-    for (int i = 0; i < 3; i++)
-    {
-        for (int j = 0; j < 3; j++)
-        {
-            if (currentState.board[i][j] == EMPTY)
-            {
-                vector<vector<char>> newBoard = currentState.board;
-                newBoard[i][j] = currentState.currentPlayer;
-                successors.push_back(State(newBoard, nextPlayer));
-            }
-        }
-    }
-
-    return successors;
-}
-
 // Evaluate the current state of the board
-int evaluateState(const State &state)
+int evaluateState(const TicTacToeBoard &board)
 {
-    if (checkWin(state.board, PLAYER_X))
+    if (board.hasWon(TTT_X))
         return 1; // X wins
-    if (checkWin(state.board, PLAYER_O))
+    if (board.hasWon(TTT_O))
         return -1; // O wins
     return 0;      // No winner
 }
 
+// Positions where X has won come first, then undecided ones, then O wins
+struct FavourXProblem : TicTacToeProblem
+{
+    int heuristic(const TicTacToeBoard &board) const
+    {
+        return 1 - evaluateState(board);
+    }
+};
+
 // Informed BFS for Tic Tac Toe
 void informedBFS()
 {
     // Initial empty board with player X starting
-    vector<vector<char>> initialBoard(3, vector<char>(3, EMPTY));
-    State initialState(initialBoard, PLAYER_X);
-
-    priority_queue<pair<int, State>> pq;
-    pq.push({0, initialState});
+    FavourXProblem problem;
+    Search<FavourXProblem> search(problem);
+    search.setBestFirstOrder(BEST_FIRST_HEAP); // ties as this program always broke them
 
-    while (!pq.empty())
+    uint32_t goal = search.greedyBestFirst(TicTacToeBoard());
+    if (goal == Search<FavourXProblem>::NO_NODE)
     {
-        State currentState = pq.top().second;
-        pq.pop();
-
-        // Check if the game is over
-        if (isGameOver(currentState.board))
-        {
-            printBoard(currentState.board);
-            cout << "Game Over" << endl;
-            return;
-        }
-
-        // Generate successors (next possible moves)
-        vector<State> successors = generateSuccessors(currentState);
-        for (State &successor : successors)
-        {
-            int heuristicCost = evaluateState(successor);
-            pq.push({heuristicCost, successor});
-        }
+        cout << "No winner" << endl;
+        return;
     }
-    cout << "No winner" << endl;
+
+    // The game is over
+    printBoard(search.arena().state(goal));
+    cout << "Game Over" << endl;
 }
 
 int main()
@@ -0,0 +1,143 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include "../Search_Common/MnkGame.h"
+#include "../Search_Common/TicTacToePerfectPlay.h"
+
+using namespace std;
+
+const char EMPTY = '_';
+const char PLAYER_X = 'X';
+const char PLAYER_O = 'O';
+
+void printBoard(const MnkGame &game)
+{
+    for (int row = 0; row < game.rows(); row++)
+    {
+        for (int col = 0; col < game.columns(); col++)
+        {
+            int owner = game.at(row * game.columns() + col);
+            cout << (owner == 0 ? PLAYER_X : owner == 1 ? PLAYER_O : EMPTY) << " ";
+        }
+        cout << endl;
+    }
+}
+
+string cellName(const MnkGame &game, int cell)
+{
+    return "(" + to_string(cell / game.columns()) + "," + to_string(cell % game.columns()) + ")";
+}
+
+// Value of an iteration as text, for the player to move
+string describe(const MnkSearch &search, const MnkSearch::Iteration &iteration)
+{
+    if (!search.isExact(iteration))
+        return "score " + to_string(iteration.value);
+    int outcome = MnkSearch::outcome(iteration);
+    int plies = MnkSearch::WIN - abs(iteration.value);
+    return outcome > 0   ? "win in " + to_string(plies) + " plies"
+           : outcome < 0 ? "loss in " + to_string(plies) + " plies"
+                         : "draw";
+}
+
+// Iterative deepening from the empty board, one line per depth
+void analyse(MnkGame &game, MnkSearch &search, int maxDepth, double millis)
+{
+    cout << "Alpha-beta on the " << game.columns() << "," << game.rows() << "," << game.inARow() << "-game ("
+         << (game.considersAllMoves() ? "every move" : "moves near stones") << "):\n";
+    MnkSearch::Iteration result = search.iterativeDeepening(maxDepth, millis, [&](const MnkSearch::Iteration &it)
+    {
+        cout << "depth " << it.depth << ": best " << cellName(game, it.move) << ", " << describe(search, it) << ", "
+             << it.nodes << " nodes, " << it.tableHits << " table hits, " << it.seconds << " s\n";
+    });
+    if (result.depth == 0)
+    {
+        cout << "No depth finished in time\n";
+        return;
+    }
+    if (!search.isExact(result))
+    {
+        cout << "Not solved: the value is an estimate\n";
+        return;
+    }
+    int outcome = MnkSearch::outcome(result);
+    cout << "Solved: " << (outcome > 0 ? "the first player wins" : outcome < 0 ? "the second player wins" : "a draw")
+         << " with perfect play\n";
+
+    // Tic-tac-toe has a compiled answer to compare with
+    if (game.columns() == 3 && game.rows() == 3 && game.inARow() == 3)
+    {
+        bool agrees = perfectValue(TicTacToeBoard()) == outcome;
+        cout << (agrees ? "Agrees" : "DISAGREES") << " with the perfect-play table\n";
+    }
+}
+
+// Both sides played by the engine, each move searched for `millis`
+void selfPlay(MnkGame &game, MnkSearch &search, int maxDepth, double millis)
+{
+    cout << "Self-play, " << millis << " ms per move:\n";
+    while (game.winnerOf() == MnkGame::NONE && !game.isFull())
+    {
+        MnkSearch::Iteration it = search.iterativeDeepening(maxDepth, millis);
+        if (it.move < 0)
+            break;
+        cout << (game.toMove() == 0 ? PLAYER_X : PLAYER_O) << " " << cellName(game, it.move) << "  depth " << it.depth
+             << ", " << describe(search, it) << endl;
+        game.play(it.move);
+    }
+    printBoard(game);
+    int winner = game.winnerOf();
+    cout << (winner == 0 ? "X wins" : winner == 1 ? "O wins" : "Draw") << " after " << game.moveCount() << " moves\n";
+}
+
+// Usage: MnkAlphaBeta [m n k] [--depth d] [--time ms] [--radius r] [--play]
+// Without --play, analyses the empty board (solving it when the search can
+// reach the end of the game); --radius 0 considers every empty cell, which
+// is the default on boards of 25 cells or fewer.
+int main(int argc, char *argv[])
+{
+    int m = 3, n = 3, k = 3;
+    int maxDepth = MnkSearch::MAX_PLY, radius = -1;
+    double millis = 10000;
+    bool play = false;
+    int arg = 1;
+    if (argc > 3 && argv[1][0] != '-')
+    {
+        m = atoi(argv[1]);
+        n = atoi(argv[2]);
+        k = atoi(argv[3]);
+        arg = 4;
+    }
+    for (; arg < argc; arg++)
+    {
+        string option = argv[arg];
+        if (option == "--depth" && arg + 1 < argc)
+            maxDepth = atoi(argv[++arg]);
+        else if (option == "--time" && arg + 1 < argc)
+            millis = atof(argv[++arg]);
+        else if (option == "--radius" && arg + 1 < argc)
+            radius = atoi(argv[++arg]);
+        else if (option == "--play")
+            play = true;
+        else
+        {
+            cout << "Unknown option " << option << endl;
+            return 1;
+        }
+    }
+    if (m < 1 || n < 1 || m > MNK_MAX_SIDE || n > MNK_MAX_SIDE || k < 2 || k > MNK_MAX_K || k > max(m, n))
+    {
+        cout << "Need sides 1-" << MNK_MAX_SIDE << " and 2 <= k <= " << MNK_MAX_K << ", k no longer than a side\n";
+        return 1;
+    }
+    if (radius < 0)
+        radius = m * n <= 25 ? 0 : 2;
+
+    MnkGame game(m, n, k, radius);
+    MnkSearch search(game);
+    if (play)
+        selfPlay(game, search, maxDepth, millis);
+    else
+        analyse(game, search, maxDepth, millis);
+    return 0;
+}
@@ -0,0 +1,160 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include "../Search_Common/MnkMcts.h"
+
+using namespace std;
+
+const char EMPTY = '_';
+const char PLAYER_X = 'X';
+const char PLAYER_O = 'O';
+
+void printBoard(const MnkGame &game)
+{
+    for (int row = 0; row < game.rows(); row++)
+    {
+        for (int col = 0; col < game.columns(); col++)
+        {
+            int owner = game.at(row * game.columns() + col);
+            cout << (owner == 0 ? PLAYER_X : owner == 1 ? PLAYER_O : EMPTY) << " ";
+        }
+        cout << endl;
+    }
+}
+
+string cellName(const MnkGame &game, int cell)
+{
+    return "(" + to_string(cell / game.columns()) + "," + to_string(cell % game.columns()) + ")";
+}
+
+string modeName(const MnkMcts::Settings &settings)
+{
+    return to_string(settings.threads) + (settings.threads == 1 ? " thread" : " threads") +
+           (settings.rootParallel ? ", root-parallel" : ", tree-parallel");
+}
+
+// One search from the empty board, with the most visited moves
+void analyse(MnkGame &game, const MnkMcts::Settings &settings)
+{
+    MnkMcts mcts(settings);
+    MnkMcts::Result result = mcts.search(game);
+    cout << "MCTS on the " << game.columns() << "," << game.rows() << "," << game.inARow() << "-game, "
+         << modeName(settings) << ":\n";
+    for (size_t i = 0; i < result.moves.size() && i < 5; i++)
+    {
+        const MnkMcts::MoveStat &stat = result.moves[i];
+        cout << cellName(game, stat.move) << ": " << stat.visits << " visits, win rate " << stat.winRate << endl;
+    }
+    cout << result.playouts << " playouts in " << result.seconds << " s (" << result.playoutsPerSecond()
+         << " playouts/sec), " << result.nodes << " tree nodes\n";
+}
+
+// Both sides played by MCTS, `settings.millis` per move
+void selfPlay(MnkGame &game, const MnkMcts::Settings &settings)
+{
+    MnkMcts mcts(settings);
+    cout << "Self-play, " << settings.millis << " ms per move, " << modeName(settings) << ":\n";
+    uint64_t playouts = 0;
+    double seconds = 0;
+    while (game.winnerOf() == MnkGame::NONE && !game.isFull())
+    {
+        MnkMcts::Result result = mcts.search(game);
+        if (result.move < 0)
+            break;
+        cout << (game.toMove() == 0 ? PLAYER_X : PLAYER_O) << " " << cellName(game, result.move) << "  win rate "
+             << result.moves[0].winRate << ", " << result.playouts << " playouts\n";
+        playouts += result.playouts;
+        seconds += result.seconds;
+        game.play(result.move);
+    }
+    printBoard(game);
+    int winner = game.winnerOf();
+    cout << (winner == 0 ? "X wins" : winner == 1 ? "O wins" : "Draw") << " after " << game.moveCount() << " moves, "
+         << (seconds > 0 ? playouts / seconds : 0) << " playouts/sec\n";
+}
+
+// Playouts per second from the empty board for 1, 2, 4, ... threads up to
+// maxThreads, in both modes, against one thread
+void scaling(MnkGame &game, MnkMcts::Settings settings, int maxThreads)
+{
+    cout << "Playout rate on the " << game.columns() << "," << game.rows() << "," << game.inARow() << "-game, "
+         << settings.millis << " ms per run, " << thread::hardware_concurrency() << " hardware threads:\n";
+    for (bool rootParallel : {false, true})
+    {
+        settings.rootParallel = rootParallel;
+        double single = 0;
+        for (int threads = 1; threads <= maxThreads; threads = threads < maxThreads ? min(threads * 2, maxThreads) : maxThreads + 1)
+        {
+            settings.threads = threads;
+            MnkMcts mcts(settings);
+            MnkMcts::Result result = mcts.search(game);
+            if (threads == 1)
+                single = result.playoutsPerSecond();
+            cout << modeName(settings) << ": " << result.playoutsPerSecond() << " playouts/sec, speedup "
+                 << (single > 0 ? result.playoutsPerSecond() / single : 0) << ", best " << cellName(game, result.move)
+                 << endl;
+        }
+    }
+}
+
+// Usage: MnkMonteCarlo [m n k] [--time ms] [--threads t] [--root-parallel]
+//                      [--playouts p] [--seed s] [--play | --scaling]
+// Defaults to gomoku (15,15,5), one thread, a second per search. --scaling
+// measures 1 to --threads threads (default: every hardware thread).
+int main(int argc, char *argv[])
+{
+    int m = 15, n = 15, k = 5;
+    MnkMcts::Settings settings;
+    int threads = 0;
+    bool play = false, measure = false;
+    int arg = 1;
+    if (argc > 3 && argv[1][0] != '-')
+    {
+        m = atoi(argv[1]);
+        n = atoi(argv[2]);
+        k = atoi(argv[3]);
+        arg = 4;
+    }
+    for (; arg < argc; arg++)
+    {
+        string option = argv[arg];
+        if (option == "--time" && arg + 1 < argc)
+            settings.millis = atof(argv[++arg]);
+        else if (option == "--threads" && arg + 1 < argc)
+            threads = max(1, atoi(argv[++arg]));
+        else if (option == "--root-parallel")
+            settings.rootParallel = true;
+        else if (option == "--playouts" && arg + 1 < argc)
+            settings.maxPlayouts = strtoull(argv[++arg], nullptr, 10);
+        else if (option == "--seed" && arg + 1 < argc)
+            settings.seed = strtoull(argv[++arg], nullptr, 10);
+        else if (option == "--play")
+            play = true;
+        else if (option == "--scaling")
+            measure = true;
+        else
+        {
+            cout << "Unknown option " << option << endl;
+            return 1;
+        }
+    }
+    if (m < 1 || n < 1 || m > MNK_MAX_SIDE || n > MNK_MAX_SIDE || k < 2 || k > MNK_MAX_K || k > max(m, n))
+    {
+        cout << "Need sides 1-" << MNK_MAX_SIDE << " and 2 <= k <= " << MNK_MAX_K << ", k no longer than a side\n";
+        return 1;
+    }
+
+    MnkGame game(m, n, k, m * n <= 25 ? 0 : 2);
+    if (measure)
+    {
+        scaling(game, settings, threads > 0 ? threads : max(1, int(thread::hardware_concurrency())));
+        return 0;
+    }
+    settings.threads = threads > 0 ? threads : 1;
+    if (play)
+        selfPlay(game, settings);
+    else
+        analyse(game, settings);
+    return 0;
+}
@@ -0,0 +1,175 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include "../Search_Common/PermutationRank.h"
+#include "../Search_Common/StateBitmap.h"
+#include "../Search_Common/PatternDatabase.h"
+#include "../Search_Common/PatternSpace.h"
+
+using namespace std;
+
+// Backward BFS over abstract states (placement of the pattern tiles, blank
+// region). Only moves of pattern tiles cost 1. Layers are kept as bitmaps
+// over placement * cell, marking the lowest cell of each region, so memory
+// stays at three bits per (placement, cell) plus one byte per placement.
+vector<uint8_t> buildPatternTable(int width, const vector<int> &tiles, const int *goalCell)
+{
+    PatternSpace space(width, tiles.data(), tiles.size(), goalCell);
+    const int cells = space.cellCount();
+    uint64_t entries = space.placements();
+    uint64_t states = space.size();
+
+    vector<uint8_t> table(entries, 255);
+    StateBitmap visited(states), current(states), next(states);
+
+    uint64_t goal = space.goalState();
+    visited.testAndSet(goal);
+    current.testAndSet(goal);
+    table[goal / cells] = 0;
+
+    uint64_t filled = 1;
+    for (int depth = 0;; depth++)
+    {
+        uint64_t layerSize = 0;
+        current.forEachSet([&](uint64_t state)
+                           {
+            layerSize++;
+            space.expand(state, [&](uint64_t nextState)
+                         {
+                if (visited.testAndSet(nextState))
+                    return;
+                next.testAndSet(nextState);
+                uint64_t nextIndex = nextState / cells;
+                if (table[nextIndex] == 255)
+                {
+                    table[nextIndex] = depth + 1;
+                    filled++;
+                } }); });
+
+        if (layerSize == 0)
+            break;
+        cout << "  depth " << depth << ": " << layerSize << " abstract states, "
+             << filled << "/" << entries << " placements" << endl;
+        swap(current, next);
+        next.clear();
+    }
+    return table;
+}
+
+// Usage: PatternDatabaseGenerator <width> <pattern sizes...> [--blank-last] [-o file]
+// Tiles are split into consecutive groups, e.g. "4 7 8" gives {1..7} and
+// {8..15} for the 15-puzzle and "5 6 6 6 6" the 6-6-6-6 24-puzzle split.
+// The goal puts tile t in cell t (blank top-left, as in Korf's instances)
+// unless --blank-last selects the 1 2 ... 0 layout.
+int main(int argc, char *argv[])
+{
+    if (argc < 3)
+    {
+        cout << "Usage: PatternDatabaseGenerator <width> <pattern sizes...> [--blank-last] [-o file]\n";
+        return 1;
+    }
+
+    int width = atoi(argv[1]);
+    vector<int> sizes;
+    bool blankLast = false;
+    string path;
+    for (int i = 2; i < argc; i++)
+    {
+        string arg = argv[i];
+        if (arg == "--blank-last")
+            blankLast = true;
+        else if (arg == "-o" && i + 1 < argc)
+            path = argv[++i];
+        else
+            sizes.push_back(atoi(argv[i]));
+    }
+
+    int cells = width * width;
+    int tileTotal = 0;
+    for (int size : sizes)
+    {
+        tileTotal += size;
+    }
+    if (width < 2 || cells > PDB_MAX_CELLS || sizes.empty() || int(sizes.size()) > PDB_MAX_PATTERNS || tileTotal != cells - 1)
+    {
+        cout << "Pattern sizes must add up to " << cells - 1 << " tiles in at most " << PDB_MAX_PATTERNS << " patterns\n";
+        return 1;
+    }
+
+    if (path.empty())
+    {
+        path = "pdb" + to_string(cells - 1);
+        for (int size : sizes)
+        {
+            path += "-" + to_string(size);
+        }
+        path += blankLast ? "-blank-last.pdb" : ".pdb";
+    }
+
+    PatternDatabaseHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, PATTERN_DATABASE_MAGIC, 4);
+    header.width = width;
+    header.patternCount = sizes.size();
+
+    int goalCell[PDB_MAX_CELLS];
+    for (int tile = 0; tile < cells; tile++)
+    {
+        goalCell[tile] = blankLast ? (tile + cells - 1) % cells : tile;
+        header.goalCell[tile] = goalCell[tile];
+        header.patternOf[tile] = 255;
+    }
+
+    vector<vector<uint8_t>> tables;
+    uint64_t offset = (sizeof(header) + 63) / 64 * 64;
+    int nextTile = 1;
+    for (size_t p = 0; p < sizes.size(); p++)
+    {
+        if (sizes[p] > PDB_MAX_PATTERN_TILES)
+        {
+            cout << "At most " << PDB_MAX_PATTERN_TILES << " tiles per pattern\n";
+            return 1;
+        }
+
+        vector<int> tiles;
+        for (int i = 0; i < sizes[p]; i++, nextTile++)
+        {
+            tiles.push_back(nextTile);
+            header.patterns[p].tiles[i] = nextTile;
+            header.patternOf[nextTile] = p;
+        }
+        header.patterns[p].tileCount = sizes[p];
+        header.patterns[p].entries = partialPermutationCount(sizes[p], cells);
+        header.patterns[p].offset = offset;
+        offset = (offset + header.patterns[p].entries + 63) / 64 * 64;
+
+        uint64_t entries = header.patterns[p].entries;
+        cout << "Pattern " << p << " (tiles " << tiles.front() << "-" << tiles.back() << "): "
+             << entries << " entries, about " << (entries + 3 * entries * cells / 8) / (1 << 20) << " MB while building\n";
+
+        auto start = chrono::steady_clock::now();
+        tables.push_back(buildPatternTable(width, tiles, goalCell));
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        cout << "  built in " << seconds << " s\n";
+    }
+
+    ofstream out(path, ios::binary);
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    for (size_t p = 0; p < tables.size(); p++)
+    {
+        out.seekp(header.patterns[p].offset);
+        out.write(reinterpret_cast<const char *>(tables[p].data()), tables[p].size());
+    }
+    if (!out)
+    {
+        cout << "Failed to write " << path << endl;
+        return 1;
+    }
+
+    cout << "Wrote " << out.tellp() << " bytes to " << path << endl;
+    return 0;
+}